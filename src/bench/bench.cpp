@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "bench.h"
+#include "settings.h"
+#include "timing.h"
+
+namespace
+{
+    volatile uint64_t consumedValue = 0;
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        double totalSeconds;
+    };
+
+    Result runCase( const Bench::Case & benchCase, const double minTimeSeconds )
+    {
+        if ( benchCase.setup )
+            benchCase.setup();
+
+        // The first run is a warm-up and isn't measured
+        benchCase.run( 0 );
+
+        Result result{ benchCase.name, 0, 0 };
+
+        uint32_t batchSize = 1;
+        uint32_t iteration = 1;
+
+        while ( result.totalSeconds < minTimeSeconds ) {
+            const fheroes2::Time timer;
+
+            for ( uint32_t i = 0; i < batchSize; ++i, ++iteration )
+                benchCase.run( iteration );
+
+            result.totalSeconds += timer.get();
+            result.iterations += batchSize;
+
+            if ( batchSize < 1024 * 1024 )
+                batchSize *= 2;
+        }
+
+        if ( benchCase.teardown )
+            benchCase.teardown();
+
+        return result;
+    }
+
+    void writeResults( std::ostream & os, const std::vector<Result> & results )
+    {
+        os << "{" << std::endl;
+        os << "  \"version\": \"" << Settings::GetVersion() << "\"," << std::endl;
+        os << "  \"benchmarks\": [" << std::endl;
+
+        for ( size_t i = 0; i < results.size(); ++i ) {
+            const Result & result = results[i];
+            const double nsPerIteration = result.totalSeconds * 1e9 / static_cast<double>( result.iterations );
+
+            os << "    { \"name\": \"" << result.name << "\", \"iterations\": " << result.iterations << ", \"total_ms\": " << std::fixed << std::setprecision( 3 )
+               << result.totalSeconds * 1000 << ", \"ns_per_iteration\": " << nsPerIteration << " }" << ( i + 1 < results.size() ? "," : "" ) << std::endl;
+        }
+
+        os << "  ]" << std::endl;
+        os << "}" << std::endl;
+    }
+
+    int printHelp( const char * basename )
+    {
+        std::cout << "Usage: " << basename << " [OPTIONS]" << std::endl;
+        std::cout << "  -f <text>\trun only benchmarks with the given text in their names" << std::endl;
+        std::cout << "  -t <ms>\tminimal measurement time of every benchmark in milliseconds, 500 by default" << std::endl;
+        std::cout << "  -o <file>\twrite JSON results to the given file instead of the standard output" << std::endl;
+        std::cout << "  -l\t\tlist available benchmarks and exit" << std::endl;
+        std::cout << "  -h\t\tprint this help message and exit" << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+}
+
+namespace Bench
+{
+    void consume( const uint64_t value )
+    {
+        consumedValue = consumedValue + value;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    std::string filter;
+    std::string outputFile;
+    double minTimeSeconds = 0.5;
+    bool listOnly = false;
+
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string option( argv[i] );
+
+        if ( option == "-f" && i + 1 < argc ) {
+            filter = argv[++i];
+        }
+        else if ( option == "-t" && i + 1 < argc ) {
+            minTimeSeconds = std::atoi( argv[++i] ) / 1000.0;
+        }
+        else if ( option == "-o" && i + 1 < argc ) {
+            outputFile = argv[++i];
+        }
+        else if ( option == "-l" ) {
+            listOnly = true;
+        }
+        else {
+            return printHelp( argv[0] );
+        }
+    }
+
+    std::vector<Bench::Case> cases;
+    Bench::appendEngineCases( cases );
+    Bench::appendGameCases( cases );
+
+    std::vector<Result> results;
+
+    for ( const Bench::Case & benchCase : cases ) {
+        if ( !filter.empty() && benchCase.name.find( filter ) == std::string::npos )
+            continue;
+
+        if ( listOnly ) {
+            std::cout << benchCase.name << std::endl;
+            continue;
+        }
+
+        std::cerr << "Running " << benchCase.name << "..." << std::endl;
+        results.push_back( runCase( benchCase, minTimeSeconds ) );
+    }
+
+    if ( listOnly )
+        return EXIT_SUCCESS;
+
+    if ( outputFile.empty() ) {
+        writeResults( std::cout, results );
+    }
+    else {
+        std::ofstream file( outputFile.c_str() );
+        if ( !file ) {
+            std::cerr << "Cannot open " << outputFile << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        writeResults( file, results );
+    }
+
+    return EXIT_SUCCESS;
+}
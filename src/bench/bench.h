@@ -0,0 +1,45 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+    // A benchmark case repeats its run function until the minimal measurement time is reached and reports the average time of one iteration.
+    // The optional setup and teardown functions are called once per case outside of the measured time.
+    struct Case
+    {
+        std::string name;
+        std::function<void()> setup;
+        std::function<void( const uint32_t iteration )> run;
+        std::function<void()> teardown;
+    };
+
+    void appendEngineCases( std::vector<Case> & cases );
+    void appendGameCases( std::vector<Case> & cases );
+
+    // Prevents the compiler from optimizing away a computation whose result is not used otherwise.
+    void consume( const uint64_t value );
+}
@@ -0,0 +1,309 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+
+#include "bench.h"
+#include "image.h"
+#include "image_tool.h"
+#include "translations.h"
+
+namespace
+{
+    // Creates a sprite looking like a typical game sprite: transparent borders, shadow pixels and blocks of the same color.
+    fheroes2::Sprite createSprite( const int32_t width, const int32_t height, const uint32_t seed )
+    {
+        std::mt19937 gen( seed );
+        std::uniform_int_distribution<int> colorDistribution( 10, 213 );
+
+        fheroes2::Sprite sprite( width, height );
+
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+
+        const int32_t centerX = width / 2;
+        const int32_t centerY = height / 2;
+        const int32_t radius = std::min( width, height ) / 2;
+
+        for ( int32_t y = 0; y < height; ++y ) {
+            const uint8_t rowColor = static_cast<uint8_t>( colorDistribution( gen ) );
+
+            for ( int32_t x = 0; x < width; ++x, ++image, ++transform ) {
+                const int32_t dx = x - centerX;
+                const int32_t dy = y - centerY;
+                const int32_t distance = dx * dx + dy * dy;
+
+                if ( distance > radius * radius ) {
+                    *image = 0;
+                    *transform = 1; // transparent
+                }
+                else if ( distance > ( radius - 2 ) * ( radius - 2 ) ) {
+                    *image = 0;
+                    *transform = 3; // shadow
+                }
+                else {
+                    *image = static_cast<uint8_t>( rowColor + ( x / 4 ) % 8 );
+                    *transform = 0;
+                }
+            }
+        }
+
+        return sprite;
+    }
+
+    // Encodes an image using the ICN format understood by fheroes2::decodeICNSprite().
+    std::vector<uint8_t> encodeICNSprite( const fheroes2::Image & sprite )
+    {
+        std::vector<uint8_t> data;
+
+        const int32_t width = sprite.width();
+
+        for ( int32_t y = 0; y < sprite.height(); ++y ) {
+            const uint8_t * image = sprite.image() + y * width;
+            const uint8_t * transform = sprite.transform() + y * width;
+
+            int32_t x = 0;
+            while ( x < width ) {
+                int32_t count = 1;
+
+                if ( transform[x] == 1 ) {
+                    while ( x + count < width && transform[x + count] == 1 && count < 0x3F )
+                        ++count;
+
+                    data.push_back( static_cast<uint8_t>( 0x80 + count ) );
+                }
+                else if ( transform[x] > 1 ) {
+                    while ( x + count < width && transform[x + count] == transform[x] && count < 0xFF )
+                        ++count;
+
+                    data.push_back( 0xC0 );
+                    data.push_back( static_cast<uint8_t>( 0x40 | ( ( transform[x] - 2 ) << 2 ) ) );
+                    data.push_back( static_cast<uint8_t>( count ) );
+                }
+                else {
+                    while ( x + count < width && transform[x + count] == 0 && image[x + count] == image[x] && count < 0x3F )
+                        ++count;
+
+                    if ( count > 1 ) {
+                        data.push_back( static_cast<uint8_t>( 0xC0 + count ) );
+                        data.push_back( image[x] );
+                    }
+                    else {
+                        while ( x + count < width && transform[x + count] == 0 && image[x + count] != image[x + count - 1] && count < 0x7F )
+                            ++count;
+
+                        data.push_back( static_cast<uint8_t>( count ) );
+                        data.insert( data.end(), image + x, image + x + count );
+                    }
+                }
+
+                x += count;
+            }
+
+            data.push_back( 0x00 );
+        }
+
+        data.push_back( 0x80 );
+
+        return data;
+    }
+
+    void putLE32( std::vector<uint8_t> & data, const uint32_t value )
+    {
+        data.push_back( static_cast<uint8_t>( value ) );
+        data.push_back( static_cast<uint8_t>( value >> 8 ) );
+        data.push_back( static_cast<uint8_t>( value >> 16 ) );
+        data.push_back( static_cast<uint8_t>( value >> 24 ) );
+    }
+
+    // Writes a GNU gettext MO file with the given original and translated strings. The first pair must be the MO file header.
+    bool writeMOFile( const std::string & path, const std::vector<std::string> & original, const std::vector<std::string> & translated )
+    {
+        const uint32_t count = static_cast<uint32_t>( original.size() );
+        const uint32_t originalTableOffset = 28;
+        const uint32_t translatedTableOffset = originalTableOffset + count * 8;
+        uint32_t stringOffset = translatedTableOffset + count * 8;
+
+        std::vector<uint8_t> header;
+        putLE32( header, 0x950412de );
+        putLE32( header, 0 ); // revision
+        putLE32( header, count );
+        putLE32( header, originalTableOffset );
+        putLE32( header, translatedTableOffset );
+        putLE32( header, 0 ); // hash table size
+        putLE32( header, 0 ); // hash table offset
+
+        std::vector<uint8_t> strings;
+
+        for ( const std::vector<std::string> * texts : { &original, &translated } ) {
+            for ( const std::string & text : *texts ) {
+                putLE32( header, static_cast<uint32_t>( text.size() ) );
+                putLE32( header, stringOffset );
+
+                strings.insert( strings.end(), text.begin(), text.end() );
+                strings.push_back( 0 );
+                stringOffset += static_cast<uint32_t>( text.size() ) + 1;
+            }
+        }
+
+        std::ofstream file( path.c_str(), std::ios::binary );
+        if ( !file )
+            return false;
+
+        file.write( reinterpret_cast<const char *>( header.data() ), static_cast<std::streamsize>( header.size() ) );
+        file.write( reinterpret_cast<const char *>( strings.data() ), static_cast<std::streamsize>( strings.size() ) );
+
+        return file.good();
+    }
+
+    struct ImageData
+    {
+        std::vector<fheroes2::Sprite> sprites;
+        // The same as the game display: a single layer image
+        fheroes2::Image display;
+        fheroes2::Image output;
+    };
+
+    struct ICNData
+    {
+        std::vector<fheroes2::Sprite> sprites;
+        std::vector<std::vector<uint8_t> > encoded;
+    };
+
+    struct TranslationData
+    {
+        std::string moFilePath;
+        std::vector<std::string> messages;
+    };
+}
+
+namespace Bench
+{
+    void appendEngineCases( std::vector<Case> & cases )
+    {
+        std::shared_ptr<ImageData> imageData = std::make_shared<ImageData>();
+        imageData->display._disableTransformLayer();
+
+        const auto imageSetup = [imageData]() {
+            imageData->sprites.clear();
+            const int32_t sizes[] = { 32, 48, 64, 96, 128 };
+            for ( uint32_t i = 0; i < 5; ++i )
+                imageData->sprites.emplace_back( createSprite( sizes[i], sizes[i] + 8, i ) );
+
+            imageData->display.resize( 640, 480 );
+            imageData->display.fill( 0 );
+        };
+
+        const auto imageTeardown = [imageData]() {
+            imageData->sprites.clear();
+            imageData->display.clear();
+            imageData->output.clear();
+        };
+
+        cases.push_back( { "image/blit", imageSetup,
+                           [imageData]( const uint32_t iteration ) {
+                               const fheroes2::Sprite & sprite = imageData->sprites[iteration % imageData->sprites.size()];
+                               fheroes2::Blit( sprite, imageData->display, static_cast<int32_t>( iteration * 37 % 512 ), static_cast<int32_t>( iteration * 53 % 352 ),
+                                               ( iteration & 1 ) != 0 );
+                           },
+                           imageTeardown } );
+
+        cases.push_back( { "image/alpha_blit", imageSetup,
+                           [imageData]( const uint32_t iteration ) {
+                               const fheroes2::Sprite & sprite = imageData->sprites[iteration % imageData->sprites.size()];
+                               fheroes2::AlphaBlit( sprite, imageData->display, static_cast<int32_t>( iteration * 37 % 512 ),
+                                                    static_cast<int32_t>( iteration * 53 % 352 ), 128, ( iteration & 1 ) != 0 );
+                           },
+                           imageTeardown } );
+
+        cases.push_back( { "image/resize_up",
+                           [imageData]() {
+                               imageData->sprites.clear();
+                               imageData->sprites.emplace_back( createSprite( 320, 240, 0 ) );
+                               imageData->output.resize( 640, 480 );
+                           },
+                           [imageData]( const uint32_t ) { fheroes2::Resize( imageData->sprites.front(), imageData->output ); }, imageTeardown } );
+
+        cases.push_back( { "image/resize_down_subpixel",
+                           [imageData]() {
+                               imageData->sprites.clear();
+                               imageData->sprites.emplace_back( createSprite( 640, 480, 0 ) );
+                               imageData->output.resize( 288, 216 );
+                           },
+                           [imageData]( const uint32_t ) { fheroes2::Resize( imageData->sprites.front(), imageData->output, true ); }, imageTeardown } );
+
+        std::shared_ptr<ICNData> icnData = std::make_shared<ICNData>();
+
+        cases.push_back( { "image/icn_decode",
+                           [icnData]() {
+                               for ( uint32_t i = 0; i < 16; ++i ) {
+                                   icnData->sprites.emplace_back( createSprite( static_cast<int32_t>( 24 + i * 8 ), static_cast<int32_t>( 40 + i * 4 ), i ) );
+                                   icnData->encoded.emplace_back( encodeICNSprite( icnData->sprites.back() ) );
+                               }
+                           },
+                           [icnData]( const uint32_t iteration ) {
+                               const size_t id = iteration % icnData->sprites.size();
+                               const fheroes2::Sprite & sprite = icnData->sprites[id];
+                               const std::vector<uint8_t> & encoded = icnData->encoded[id];
+
+                               const fheroes2::Sprite decoded
+                                   = fheroes2::decodeICNSprite( encoded.data(), static_cast<uint32_t>( encoded.size() ), sprite.width(), sprite.height(), 0, 0 );
+                               consume( decoded.image()[0] );
+                           },
+                           [icnData]() {
+                               icnData->sprites.clear();
+                               icnData->encoded.clear();
+                           } } );
+
+        std::shared_ptr<TranslationData> translationData = std::make_shared<TranslationData>();
+
+        cases.push_back( { "translation/gettext",
+                           [translationData]() {
+                               std::vector<std::string> original{ "" };
+                               std::vector<std::string> translated{ "Content-Type: text/plain; charset=UTF-8\nPlural-Forms: nplurals=2; plural=(n != 1);\n" };
+
+                               for ( uint32_t i = 0; i < 2000; ++i ) {
+                                   original.emplace_back( "The hero has found " + std::to_string( i ) + " pieces of gold." );
+                                   translated.emplace_back( "Der Held hat " + std::to_string( i ) + " Goldstücke gefunden." );
+                               }
+
+                               translationData->messages.assign( original.begin() + 1, original.end() );
+                               translationData->moFilePath = "fheroes2-bench.mo";
+
+                               if ( writeMOFile( translationData->moFilePath, original, translated ) ) {
+                                   Translation::bindDomain( "de", translationData->moFilePath.c_str() );
+                                   Translation::setDomain( "de" );
+                               }
+                           },
+                           [translationData]( const uint32_t iteration ) {
+                               const std::string & message = translationData->messages[iteration % translationData->messages.size()];
+                               consume( static_cast<uint8_t>( *Translation::gettext( message ) ) );
+                           },
+                           [translationData]() {
+                               Translation::reset();
+                               std::remove( translationData->moFilePath.c_str() );
+                               translationData->messages.clear();
+                           } } );
+    }
+}
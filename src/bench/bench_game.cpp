@@ -0,0 +1,206 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <memory>
+#include <thread>
+
+#include "ai_battle_estimator.h"
+#include "army.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "bench.h"
+#include "color.h"
+#include "game_session.h"
+#include "maps_tiles.h"
+#include "monster.h"
+#include "mp2.h"
+#include "parallel.h"
+#include "rand.h"
+#include "serialize.h"
+#include "skill.h"
+#include "world.h"
+#include "world_pathfinding.h"
+
+namespace
+{
+    // Creates a deterministic map of the given size with patches of different terrains and lakes without reading any map file.
+    void createSyntheticWorld( const int32_t size )
+    {
+        world.NewMaps( size, size );
+
+        // First tile indexes of grass, snow, swamp, desert and dirt in GROUND32.TIL
+        const uint16_t landTiles[] = { 30, 92, 146, 262, 321 };
+
+        for ( int32_t y = 0; y < size; ++y ) {
+            for ( int32_t x = 0; x < size; ++x ) {
+                const bool isWater = ( ( x / 12 + y / 9 ) % 5 == 0 ) && ( x % 12 > 3 ) && ( y % 9 > 2 );
+
+                MP2::mp2tile_t mp2tile;
+                mp2tile.surfaceType = isWater ? static_cast<uint16_t>( 16 + ( x + y ) % 4 ) : static_cast<uint16_t>( landTiles[( x / 16 + y / 16 ) % 5] + ( x * y ) % 8 );
+                mp2tile.objectName1 = 0;
+                mp2tile.level1IcnImageIndex = 0xff;
+                mp2tile.quantity1 = 0;
+                mp2tile.quantity2 = 0;
+                mp2tile.objectName2 = 0;
+                mp2tile.level2IcnImageIndex = 0xff;
+                mp2tile.flags = 0;
+                mp2tile.mapObjectType = MP2::OBJ_ZERO;
+                mp2tile.nextAddonIndex = 0;
+                mp2tile.level1ObjectUID = 0;
+                mp2tile.level2ObjectUID = 0;
+
+                world.GetTiles( x, y ).Init( y * size + x, mp2tile );
+            }
+        }
+
+        // A save and load cycle builds all data derived from the map tiles, just like for a saved game.
+        StreamBuf buffer( 1024 * 1024 );
+        buffer << world;
+        buffer >> world;
+    }
+
+    void setArmy( Army & army, const std::vector<std::pair<int, uint32_t> > & troops )
+    {
+        army.Reset( false );
+        army.Clean();
+
+        for ( const std::pair<int, uint32_t> & troop : troops )
+            army.JoinTroop( Monster( troop.first ), troop.second, true );
+    }
+
+    struct BattleData
+    {
+        Army army1;
+        Army army2;
+        Rand::DeterministicRandomGenerator randomGenerator{ 1 };
+        std::unique_ptr<Battle::Arena> arena;
+        Battle::ArenaPathfinder pathfinder;
+        AI::BattleEstimator estimator;
+    };
+
+    void appendWorldPathfinderCase( std::vector<Bench::Case> & cases, const int32_t size )
+    {
+        std::shared_ptr<AIWorldPathfinder> pathfinder = std::make_shared<AIWorldPathfinder>( 1.5 );
+
+        cases.push_back( { "world/ai_pathfinder_flood_" + std::to_string( size ), [size]() { createSyntheticWorld( size ); },
+                           [pathfinder, size]( const uint32_t iteration ) {
+                               // Different army strength forces the full re-evaluation of the map every time
+                               const int32_t start = static_cast<int32_t>( ( iteration * 7919 ) % static_cast<uint32_t>( size * size ) );
+                               pathfinder->reEvaluateIfNeeded( start, Color::BLUE, 1000.0 + iteration, Skill::Level::NONE );
+                               Bench::consume( pathfinder->getDistance( 0 ) );
+                           },
+                           [pathfinder]() { pathfinder->reset(); } } );
+    }
+
+    // Every thread plays its own headless game session like a simulation farm does: the session creates a world and floods it with
+    // the pathfinder. Compare with world/ai_pathfinder_flood_72 to see how well sessions scale.
+    void appendParallelSessionsCase( std::vector<Bench::Case> & cases, const int32_t size )
+    {
+        cases.push_back( { "session/parallel_pathfinder_flood_" + std::to_string( size ), nullptr,
+                           [size]( const uint32_t iteration ) {
+                               std::vector<uint32_t> distances( fheroes2::getWorkerThreadCount() );
+
+                               std::vector<std::thread> threads;
+                               threads.reserve( distances.size() );
+
+                               for ( size_t i = 0; i < distances.size(); ++i ) {
+                                   threads.emplace_back( [size, iteration, i, &distances]() {
+                                       Game::Session session;
+                                       const Game::SessionScope sessionScope( session );
+
+                                       createSyntheticWorld( size );
+
+                                       AIWorldPathfinder pathfinder( 1.5 );
+                                       const int32_t start = static_cast<int32_t>( ( ( iteration + i ) * 7919 ) % static_cast<uint32_t>( size * size ) );
+                                       pathfinder.reEvaluateIfNeeded( start, Color::BLUE, 1000.0, Skill::Level::NONE );
+                                       distances[i] = pathfinder.getDistance( 0 );
+                                   } );
+                               }
+
+                               for ( std::thread & thread : threads ) {
+                                   thread.join();
+                               }
+
+                               for ( const uint32_t distance : distances ) {
+                                   Bench::consume( distance );
+                               }
+                           },
+                           nullptr } );
+    }
+}
+
+namespace Bench
+{
+    void appendGameCases( std::vector<Case> & cases )
+    {
+        appendWorldPathfinderCase( cases, 36 );
+        appendWorldPathfinderCase( cases, 72 );
+        appendWorldPathfinderCase( cases, 144 );
+
+        appendParallelSessionsCase( cases, 72 );
+
+        cases.push_back( { "world/save_load_144", []() { createSyntheticWorld( 144 ); },
+                           []( const uint32_t ) {
+                               StreamBuf buffer( 1024 * 1024 );
+                               buffer << world;
+                               buffer >> world;
+                               Bench::consume( buffer.size() );
+                           },
+                           nullptr } );
+
+        std::shared_ptr<BattleData> battleData = std::make_shared<BattleData>();
+
+        cases.push_back( { "battle/arena_pathfinder",
+                           [battleData]() {
+                               createSyntheticWorld( 36 );
+
+                               setArmy( battleData->army1, { { Monster::PIKEMAN, 20 }, { Monster::GRIFFIN, 5 }, { Monster::ARCHER, 10 }, { Monster::CAVALRY, 4 } } );
+                               setArmy( battleData->army2,
+                                        { { Monster::GOBLIN, 30 }, { Monster::WOLF, 8 }, { Monster::ORC, 12 }, { Monster::OGRE, 3 }, { Monster::ROC, 2 } } );
+
+                               battleData->arena.reset( new Battle::Arena( battleData->army1, battleData->army2, 0, false, battleData->randomGenerator ) );
+                           },
+                           [battleData]( const uint32_t iteration ) {
+                               Battle::Force & force = ( iteration & 1 ) ? battleData->arena->GetForce2() : battleData->arena->GetForce1();
+                               const Battle::Unit * unit = force[( iteration / 2 ) % force.size()];
+
+                               battleData->pathfinder.calculate( *unit );
+                               Bench::consume( battleData->pathfinder.hexIsPassable( 0 ) );
+                           },
+                           [battleData]() { battleData->arena.reset(); } } );
+
+        cases.push_back( { "ai/battle_estimate",
+                           [battleData]() {
+                               createSyntheticWorld( 36 );
+
+                               setArmy( battleData->army1, { { Monster::PIKEMAN, 20 }, { Monster::GRIFFIN, 5 }, { Monster::ARCHER, 10 }, { Monster::CAVALRY, 4 } } );
+                               setArmy( battleData->army2,
+                                        { { Monster::GOBLIN, 30 }, { Monster::WOLF, 8 }, { Monster::ORC, 12 }, { Monster::OGRE, 3 }, { Monster::ROC, 2 } } );
+                           },
+                           [battleData]( const uint32_t iteration ) {
+                               // Changing army size avoids hitting the estimation cache
+                               battleData->army1.GetTroop( 0 )->SetCount( 20 + iteration );
+
+                               Bench::consume( static_cast<uint64_t>( battleData->estimator.estimate( battleData->army1, battleData->army2, 0 ).winProbability * 1000 ) );
+                           },
+                           [battleData]() { battleData->estimator.clear(); } } );
+    }
+}
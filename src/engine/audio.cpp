@@ -24,11 +24,13 @@
 #include <atomic>
 #include <mutex>
 #include <numeric>
+#include <set>
 
 #include <SDL.h>
 #include <SDL_mixer.h>
 
 #include "audio.h"
+#include "cache_tracker.h"
 #include "core.h"
 #include "logging.h"
 #include "system.h"
@@ -66,15 +68,79 @@ namespace
 
     std::recursive_mutex mutex;
 
+    // Sounds already converted into the audio device format. The cache is indexed by sound IDs and protected by the main mutex.
+    std::vector<Mix_Chunk *> chunkCache;
+    fheroes2::CacheTracker chunkCacheTracker( 0 );
+
+    // FreeChannel() is called by SDL from the audio thread so it must not lock the main mutex to avoid a deadlock.
+    // Therefore cached chunks are additionally registered in this set which has its own mutex.
+    std::set<const Mix_Chunk *> cachedChunks;
+    std::mutex cachedChunksMutex;
+
+    bool isCachedChunk( const Mix_Chunk * sample )
+    {
+        const std::lock_guard<std::mutex> guard( cachedChunksMutex );
+
+        return cachedChunks.count( sample ) > 0;
+    }
+
     void FreeChannel( const int channel )
     {
         Mix_Chunk * sample = Mix_GetChunk( channel );
 
-        if ( sample ) {
+        if ( sample && !isCachedChunk( sample ) ) {
             Mix_FreeChunk( sample );
         }
     }
 
+    bool isChunkPlaying( const Mix_Chunk * sample )
+    {
+        const int channelsCount = Mix_AllocateChannels( -1 );
+
+        for ( int channel = 0; channel < channelsCount; ++channel ) {
+            if ( Mix_Playing( channel ) > 0 && Mix_GetChunk( channel ) == sample ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void FreeCachedChunk( const size_t soundId )
+    {
+        Mix_Chunk * sample = chunkCache[soundId];
+        if ( sample == nullptr ) {
+            return;
+        }
+
+        {
+            const std::lock_guard<std::mutex> guard( cachedChunksMutex );
+            cachedChunks.erase( sample );
+        }
+
+        Mix_FreeChunk( sample );
+
+        chunkCache[soundId] = nullptr;
+        chunkCacheTracker.release( soundId );
+    }
+
+    void ReleaseUnusedChunks()
+    {
+        // Chunks which are being played cannot be released.
+        const std::vector<size_t> evictionList = chunkCacheTracker.getEvictionList( []( const size_t soundId ) { return isChunkPlaying( chunkCache[soundId] ); } );
+
+        for ( const size_t soundId : evictionList ) {
+            FreeCachedChunk( soundId );
+        }
+    }
+
+    void ClearChunkCache()
+    {
+        for ( size_t soundId = 0; soundId < chunkCache.size(); ++soundId ) {
+            FreeCachedChunk( soundId );
+        }
+    }
+
     Mix_Chunk * LoadWAV( const std::string & file )
     {
         Mix_Chunk * sample = Mix_LoadWAV( System::FileNameToUTF8( file ).c_str() );
@@ -165,6 +231,8 @@ void Audio::Quit()
         Music::Reset();
         Mixer::Reset();
 
+        ClearChunkCache();
+
         valid = false;
 
         Mix_CloseAudio();
@@ -279,6 +347,76 @@ int Mixer::Play( const uint8_t * ptr, const uint32_t size, const int channel /*
     return -1;
 }
 
+bool Mixer::isCached( const int soundId )
+{
+    const std::lock_guard<std::recursive_mutex> guard( mutex );
+
+    return soundId >= 0 && static_cast<size_t>( soundId ) < chunkCache.size() && chunkCache[soundId] != nullptr;
+}
+
+int Mixer::PlayCached( const int soundId, const uint8_t * ptr, const uint32_t size, const int channel /* = -1 */, const bool loop /* = false */ )
+{
+    const std::lock_guard<std::recursive_mutex> guard( mutex );
+
+    if ( !valid || soundId < 0 ) {
+        return -1;
+    }
+
+    const size_t cacheId = static_cast<size_t>( soundId );
+
+    if ( cacheId < chunkCache.size() && chunkCache[cacheId] != nullptr ) {
+        chunkCacheTracker.hit( cacheId );
+
+        Mix_ChannelFinished( FreeChannel );
+        return PlayChunk( chunkCache[cacheId], channel, loop );
+    }
+
+    if ( ptr == nullptr ) {
+        return -1;
+    }
+
+    Mix_Chunk * sample = LoadWAV( ptr, size );
+    if ( sample == nullptr ) {
+        return -1;
+    }
+
+    if ( cacheId >= chunkCache.size() ) {
+        chunkCache.resize( cacheId + 1, nullptr );
+    }
+
+    chunkCache[cacheId] = sample;
+
+    {
+        const std::lock_guard<std::mutex> chunkGuard( cachedChunksMutex );
+        cachedChunks.insert( sample );
+    }
+
+    chunkCacheTracker.miss( cacheId );
+    chunkCacheTracker.setSize( cacheId, sample->alen );
+
+    Mix_ChannelFinished( FreeChannel );
+    const int result = PlayChunk( sample, channel, loop );
+
+    // The new chunk is being played now so it will not be released.
+    ReleaseUnusedChunks();
+
+    return result;
+}
+
+void Mixer::SetCacheLimit( const size_t bytes )
+{
+    const std::lock_guard<std::recursive_mutex> guard( mutex );
+
+    chunkCacheTracker.setLimit( bytes );
+}
+
+fheroes2::CacheStatistics Mixer::GetCacheStatistics()
+{
+    const std::lock_guard<std::recursive_mutex> guard( mutex );
+
+    return chunkCacheTracker.statistics();
+}
+
 int Mixer::MaxVolume()
 {
     return MIX_MAX_VOLUME;
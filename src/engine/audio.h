@@ -23,10 +23,16 @@
 #ifndef H2AUDIO_H
 #define H2AUDIO_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+namespace fheroes2
+{
+    struct CacheStatistics;
+}
+
 namespace Audio
 {
     void Init();
@@ -47,6 +53,15 @@ namespace Mixer
     int Play( const std::string & file, const int channel = -1, const bool loop = false );
     int Play( const uint8_t * ptr, const uint32_t size, const int channel = -1, const bool loop = false );
 
+    // Play a sound kept in the cache of sounds converted into the audio device format. Sound data is decoded and added to the cache
+    // only if the sound with such ID is not cached yet, otherwise ptr and size are ignored. Playing sounds are never evicted.
+    bool isCached( const int soundId );
+    int PlayCached( const int soundId, const uint8_t * ptr, const uint32_t size, const int channel = -1, const bool loop = false );
+
+    // Set the maximum amount of memory in bytes used by cached sounds. 0 means no limit.
+    void SetCacheLimit( const size_t bytes );
+    fheroes2::CacheStatistics GetCacheStatistics();
+
     int MaxVolume();
     int Volume( const int channel, int vol );
 
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <sstream>
+
+#include "cache_tracker.h"
+
+namespace fheroes2
+{
+    std::string CacheStatistics::String() const
+    {
+        std::ostringstream os;
+        os << "hits: " << hits << ", misses: " << misses << ", evictions: " << evictions << ", used memory: " << usedBytes << " bytes";
+        if ( limitBytes > 0 ) {
+            os << " of " << limitBytes;
+        }
+
+        return os.str();
+    }
+
+    CacheTracker::CacheTracker( const size_t keyCount )
+        : _lastAccess( keyCount, 0 )
+        , _size( keyCount, 0 )
+        , _accessCounter( 0 )
+    {}
+
+    void CacheTracker::setLimit( const size_t bytes )
+    {
+        _statistics.limitBytes = bytes;
+    }
+
+    void CacheTracker::miss( const size_t key )
+    {
+        ++_statistics.misses;
+
+        _extendKeys( key );
+        _lastAccess[key] = ++_accessCounter;
+    }
+
+    void CacheTracker::setSize( const size_t key, const size_t bytes )
+    {
+        _extendKeys( key );
+
+        _statistics.usedBytes -= _size[key];
+        _size[key] = bytes;
+        _statistics.usedBytes += bytes;
+    }
+
+    void CacheTracker::release( const size_t key )
+    {
+        setSize( key, 0 );
+        _lastAccess[key] = 0;
+    }
+
+    void CacheTracker::_extendKeys( const size_t key )
+    {
+        if ( key >= _size.size() ) {
+            _lastAccess.resize( key + 1, 0 );
+            _size.resize( key + 1, 0 );
+        }
+    }
+
+    std::vector<size_t> CacheTracker::getEvictionList( const std::function<bool( const size_t )> & isPinned )
+    {
+        std::vector<size_t> evictionList;
+
+        if ( _statistics.limitBytes == 0 || _statistics.usedBytes <= _statistics.limitBytes ) {
+            return evictionList;
+        }
+
+        std::vector<size_t> candidates;
+        for ( size_t key = 0; key < _size.size(); ++key ) {
+            if ( _size[key] > 0 && !isPinned( key ) ) {
+                candidates.push_back( key );
+            }
+        }
+
+        std::sort( candidates.begin(), candidates.end(), [this]( const size_t left, const size_t right ) { return _lastAccess[left] < _lastAccess[right]; } );
+
+        size_t usedBytes = _statistics.usedBytes;
+        for ( const size_t key : candidates ) {
+            if ( usedBytes <= _statistics.limitBytes ) {
+                break;
+            }
+
+            usedBytes -= _size[key];
+            evictionList.push_back( key );
+        }
+
+        _statistics.evictions += evictionList.size();
+
+        return evictionList;
+    }
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fheroes2
+{
+    struct CacheStatistics
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t usedBytes = 0;
+        size_t limitBytes = 0; // 0 means that the cache has no limit
+
+        std::string String() const;
+    };
+
+    // Keeps track of memory used by cached items and their access order. Items are identified by dense integer keys
+    // (resource IDs) so that the access registration costs only a store into an array. The key range is extended on demand.
+    // This class does not own cached items and it is not thread-safe: the owner of the cache must synchronize calls if needed.
+    class CacheTracker
+    {
+    public:
+        explicit CacheTracker( const size_t keyCount );
+
+        void setLimit( const size_t bytes );
+
+        void hit( const size_t key )
+        {
+            assert( key < _lastAccess.size() );
+
+            ++_statistics.hits;
+            _lastAccess[key] = ++_accessCounter;
+        }
+
+        void miss( const size_t key );
+
+        // Updates the size of an item in bytes. Use 0 for items which are not loaded.
+        void setSize( const size_t key, const size_t bytes );
+
+        // Registers an item removed from the cache by its owner.
+        void release( const size_t key );
+
+        // Returns keys of the least recently used items which must be released to fit the limit, in the order of release.
+        // Items for which isPinned() returns true are never returned. The caller must release all returned items.
+        std::vector<size_t> getEvictionList( const std::function<bool( const size_t )> & isPinned );
+
+        const CacheStatistics & statistics() const
+        {
+            return _statistics;
+        }
+
+    private:
+        void _extendKeys( const size_t key );
+
+        std::vector<uint64_t> _lastAccess;
+        std::vector<size_t> _size;
+
+        uint64_t _accessCounter;
+
+        CacheStatistics _statistics;
+    };
+}
@@ -20,8 +20,11 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+
 #include "localevent.h"
 #include "audio.h"
+#include "logging.h"
 #include "pal.h"
 #include "screen.h"
 
@@ -37,6 +40,16 @@ namespace
         MOD_NUM = KMOD_NUM
     };
 
+    // The number of recent frames used for frame time percentiles.
+    const size_t frameStatisticsWindow = 256;
+
+    // The upper limit of waiting for events when no animation is running. Every game animation is driven by TimeDelay
+    // so its deadline shortens the waiting time automatically.
+    const uint64_t maxEventWaitMs = 100;
+
+    // Controller stick motion is processed on every frame so the waiting time must be short while the controller is connected.
+    const uint64_t maxControllerEventWaitMs = 10;
+
     char CharFromKeySym( const KeySym sym, const int32_t mod )
     {
         switch ( sym ) {
@@ -431,6 +444,7 @@ LocalEvent::LocalEvent()
     , redraw_cursor_func( nullptr )
     , keyboard_filter_func( nullptr )
     , loop_delay( 1 )
+    , _frameStatistics( frameStatisticsWindow )
 {}
 
 #if SDL_VERSION_ATLEAST( 2, 0, 0 )
@@ -970,6 +984,8 @@ size_t InsertKeySym( std::string & res, size_t pos, const KeySym sym, const int3
 
 namespace
 {
+    const uint64_t cyclingDelayMs = 220;
+
     class ColorCycling
     {
     public:
@@ -985,7 +1001,7 @@ namespace
             if ( _preRenderDrawing != nullptr )
                 _preRenderDrawing();
 
-            if ( _timer.getMs() >= 220 ) {
+            if ( _timer.getMs() >= cyclingDelayMs ) {
                 _timer.reset();
                 palette = PAL::GetCyclingPalette( _counter );
                 ++_counter;
@@ -1002,9 +1018,21 @@ namespace
                 _posRenderDrawing();
         }
 
+        // Rendering is needed only when nothing was rendered during the cycling period and the palette is due to change.
         bool isRedrawRequired() const
         {
-            return !_isPaused && _prevDraw.getMs() >= 220;
+            return !_isPaused && _prevDraw.getMs() >= cyclingDelayMs && _timer.getMs() >= cyclingDelayMs;
+        }
+
+        // Returns the time in milliseconds until the next redraw or maxDelayMs if cycling is paused.
+        uint64_t getRedrawDeadline( const uint64_t maxDelayMs ) const
+        {
+            if ( _isPaused ) {
+                return maxDelayMs;
+            }
+
+            const uint64_t passedMs = std::min( _prevDraw.getMs(), _timer.getMs() );
+            return passedMs >= cyclingDelayMs ? 0 : std::min( cyclingDelayMs - passedMs, maxDelayMs );
         }
 
         void registerDrawing( void ( *preRenderDrawing )(), void ( *postRenderDrawing )() )
@@ -1091,20 +1119,16 @@ LocalEvent & LocalEvent::GetClean()
 
 bool LocalEvent::HandleEvents( bool delay, bool allowExit )
 {
+    _frameStatistics.addFrame( _frameTimer.get() * 1000 );
+    if ( _frameStatistics.frameCount() % frameStatisticsWindow == 0 ) {
+        DEBUG_LOG( DBG_ENGINE, DBG_TRACE,
+                   "frame time: 50% " << _frameStatistics.getPercentile( 50 ) << " ms, 95% " << _frameStatistics.getPercentile( 95 ) << " ms, 99% "
+                                      << _frameStatistics.getPercentile( 99 ) << " ms" )
+    }
+
     if ( colorCycling.isRedrawRequired() ) {
         // Looks like there is no explicit rendering so the code for color cycling was executed here.
-        if ( delay ) {
-            fheroes2::Time timeCheck;
-            fheroes2::Display::instance().render();
-
-            if ( timeCheck.getMs() > loop_delay ) {
-                // Since rendering took more than waiting time so we should not wait.
-                delay = false;
-            }
-        }
-        else {
-            fheroes2::Display::instance().render();
-        }
+        fheroes2::Display::instance().render();
     }
 
     SDL_Event event;
@@ -1210,8 +1234,21 @@ bool LocalEvent::HandleEvents( bool delay, bool allowExit )
     }
 #endif
 
+#if SDL_VERSION_ATLEAST( 2, 0, 0 )
+    // Deadlines must be collected on every call even without waiting, otherwise they become outdated.
+    const uint64_t maxWaitMs = ( _gameController != nullptr ) ? maxControllerEventWaitMs : maxEventWaitMs;
+    const uint64_t waitMs = colorCycling.getRedrawDeadline( fheroes2::getAnimationDeadline( maxWaitMs ) );
+
+    if ( delay && waitMs > 0 ) {
+        // The event is not removed from the queue so it is going to be handled by the next call.
+        SDL_WaitEventTimeout( nullptr, static_cast<int>( waitMs ) );
+    }
+#else
     if ( delay )
         SDL_Delay( loop_delay );
+#endif
+
+    _frameTimer.reset();
 
     return true;
 }
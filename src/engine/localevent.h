@@ -187,8 +187,15 @@ public:
     static void SetStateDefaults( void );
     static void SetState( u32 type, bool enable );
 
+    // If delay is set the function waits for new events until the nearest animation deadline instead of polling them.
     bool HandleEvents( bool delay = true, bool allowExit = false );
 
+    // Time spent by the caller between two consecutive calls of HandleEvents() excluding the time of waiting for events.
+    const fheroes2::FrameTimeStatistics & GetFrameTimeStatistics() const
+    {
+        return _frameStatistics;
+    }
+
     bool MouseMotion( void ) const;
 
     const fheroes2::Point & GetMouseCursor( void ) const
@@ -323,6 +330,9 @@ private:
 
     uint32_t loop_delay;
 
+    fheroes2::Time _frameTimer;
+    fheroes2::FrameTimeStatistics _frameStatistics;
+
     enum
     {
         CONTROLLER_L_DEADZONE = 4000,
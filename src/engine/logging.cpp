@@ -20,6 +20,18 @@
 
 #include <ctime>
 
+#if defined( WITH_ASYNC_LOG )
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+#endif
+
 #if defined( __MINGW32__ ) || defined( _MSC_VER )
 #include <windows.h>
 #endif
@@ -60,6 +72,310 @@ namespace
 
     const ConsoleCPSwitcher consoleCPSwitcher;
 #endif
+
+#if defined( WITH_ASYNC_LOG )
+    // All debug categories plus verbose records.
+    const size_t logCategoryCount = 8;
+
+    // Bounded multi-producer single-consumer queue. Every cell has a sequence number which tells whether the cell is free for
+    // a producer or contains a record for the consumer so neither side ever takes a lock.
+    class RecordQueue
+    {
+    public:
+        explicit RecordQueue( const size_t capacity )
+            : _cells( capacity )
+            , _mask( capacity - 1 )
+            , _enqueuePos( 0 )
+            , _dequeuePos( 0 )
+        {
+            assert( capacity >= 2 && ( capacity & ( capacity - 1 ) ) == 0 );
+
+            for ( size_t i = 0; i < capacity; ++i ) {
+                _cells[i].sequence.store( i, std::memory_order_relaxed );
+            }
+        }
+
+        RecordQueue( const RecordQueue & ) = delete;
+        RecordQueue & operator=( const RecordQueue & ) = delete;
+
+        // Returns false if the queue is full.
+        bool push( std::string && record )
+        {
+            size_t pos = _enqueuePos.load( std::memory_order_relaxed );
+
+            while ( true ) {
+                Cell & cell = _cells[pos & _mask];
+                const size_t sequence = cell.sequence.load( std::memory_order_acquire );
+                const intptr_t diff = static_cast<intptr_t>( sequence ) - static_cast<intptr_t>( pos );
+
+                if ( diff == 0 ) {
+                    if ( _enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                        cell.record = std::move( record );
+                        cell.sequence.store( pos + 1, std::memory_order_release );
+                        return true;
+                    }
+                }
+                else if ( diff < 0 ) {
+                    return false;
+                }
+                else {
+                    pos = _enqueuePos.load( std::memory_order_relaxed );
+                }
+            }
+        }
+
+        // Must be called only from the consumer thread.
+        bool pop( std::string & record )
+        {
+            Cell & cell = _cells[_dequeuePos & _mask];
+            if ( cell.sequence.load( std::memory_order_acquire ) != _dequeuePos + 1 ) {
+                return false;
+            }
+
+            record = std::move( cell.record );
+            cell.record.clear();
+            cell.sequence.store( _dequeuePos + _mask + 1, std::memory_order_release );
+            ++_dequeuePos;
+
+            return true;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            std::string record;
+        };
+
+        std::vector<Cell> _cells;
+        const size_t _mask;
+        std::atomic<size_t> _enqueuePos;
+        size_t _dequeuePos;
+    };
+
+    // Every debug category plus verbose records are limited to a number of records per second. The counters are reset
+    // by the first record of a new second and the amount of suppressed records is reported in the log.
+    class RateLimiter
+    {
+    public:
+        RateLimiter()
+        {
+            for ( Category & category : _categories ) {
+                category.second.store( 0, std::memory_order_relaxed );
+                category.count.store( 0, std::memory_order_relaxed );
+                category.suppressed.store( 0, std::memory_order_relaxed );
+            }
+        }
+
+        bool isAllowed( const size_t categoryId, uint32_t & suppressedBefore )
+        {
+            assert( categoryId < _categories.size() );
+            Category & category = _categories[categoryId];
+
+            const uint32_t now = currentSecond();
+            uint32_t second = category.second.load( std::memory_order_relaxed );
+            if ( second != now && category.second.compare_exchange_strong( second, now, std::memory_order_relaxed ) ) {
+                category.count.store( 0, std::memory_order_relaxed );
+                suppressedBefore = category.suppressed.exchange( 0, std::memory_order_relaxed );
+            }
+
+            if ( category.count.fetch_add( 1, std::memory_order_relaxed ) < maxRecordsPerSecond ) {
+                return true;
+            }
+
+            category.suppressed.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        }
+
+        uint32_t takeSuppressed( const size_t categoryId )
+        {
+            assert( categoryId < _categories.size() );
+            return _categories[categoryId].suppressed.exchange( 0, std::memory_order_relaxed );
+        }
+
+    private:
+        struct Category
+        {
+            std::atomic<uint32_t> second;
+            std::atomic<uint32_t> count;
+            std::atomic<uint32_t> suppressed;
+        };
+
+        static const uint32_t maxRecordsPerSecond = 5000;
+
+        std::array<Category, logCategoryCount> _categories;
+
+        static uint32_t currentSecond()
+        {
+            return static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::seconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+        }
+    };
+
+    class AsyncLogWriter
+    {
+    public:
+        AsyncLogWriter()
+            : _queue( 16384 )
+            , _isRunning( false )
+            , _droppedRecords( 0 )
+        {}
+
+        AsyncLogWriter( const AsyncLogWriter & ) = delete;
+        AsyncLogWriter & operator=( const AsyncLogWriter & ) = delete;
+
+        ~AsyncLogWriter()
+        {
+            stop();
+        }
+
+        void start( const std::string & fileName )
+        {
+            if ( _worker ) {
+                return;
+            }
+
+            _file.open( fileName, std::ofstream::out );
+
+            _isRunning.store( true, std::memory_order_release );
+            _worker.reset( new std::thread( AsyncLogWriter::_workerThread, this ) );
+        }
+
+        void stop()
+        {
+            if ( !_worker ) {
+                return;
+            }
+
+            for ( size_t categoryId = 0; categoryId < logCategoryCount; ++categoryId ) {
+                const uint32_t suppressed = _rateLimiter.takeSuppressed( categoryId );
+                if ( suppressed > 0 ) {
+                    push( getSuppressedRecord( categoryId, suppressed ) );
+                }
+            }
+
+            _isRunning.store( false, std::memory_order_release );
+            _worker->join();
+            _worker.reset();
+
+            // Records which were pushed while the writer thread was finishing.
+            std::string record;
+            while ( _queue.pop( record ) ) {
+                _output() << record << '\n';
+            }
+
+            _file.close();
+        }
+
+        bool isAllowed( const int name )
+        {
+            const size_t categoryId = getCategoryId( name );
+
+            uint32_t suppressedBefore = 0;
+            const bool isAllowed = _rateLimiter.isAllowed( categoryId, suppressedBefore );
+
+            if ( suppressedBefore > 0 ) {
+                push( getSuppressedRecord( categoryId, suppressedBefore ) );
+            }
+
+            return isAllowed;
+        }
+
+        void push( std::string && record )
+        {
+            if ( !_isRunning.load( std::memory_order_acquire ) ) {
+                // The writer is not started yet or already stopped.
+                std::cerr << record << std::endl;
+                return;
+            }
+
+            if ( !_queue.push( std::move( record ) ) ) {
+                _droppedRecords.fetch_add( 1, std::memory_order_relaxed );
+            }
+        }
+
+    private:
+        RecordQueue _queue;
+        RateLimiter _rateLimiter;
+
+        std::unique_ptr<std::thread> _worker;
+        std::atomic<bool> _isRunning;
+        std::atomic<uint32_t> _droppedRecords;
+
+        std::ofstream _file;
+
+        std::ostream & _output()
+        {
+            if ( _file.is_open() ) {
+                return _file;
+            }
+
+            return std::cerr;
+        }
+
+        static const int * getCategories()
+        {
+            static const int categories[logCategoryCount - 1] = { DBG_ENGINE, DBG_GAME, DBG_BATTLE, DBG_AI, DBG_NETWORK, DBG_OTHER, DBG_DEVEL };
+            return categories;
+        }
+
+        static size_t getCategoryId( const int name )
+        {
+            const int * categories = getCategories();
+            for ( size_t i = 0; i < logCategoryCount - 1; ++i ) {
+                if ( name & categories[i] ) {
+                    return i;
+                }
+            }
+
+            // Verbose records.
+            return logCategoryCount - 1;
+        }
+
+        static std::string getSuppressedRecord( const size_t categoryId, const uint32_t suppressed )
+        {
+            const char * categoryName = categoryId < logCategoryCount - 1 ? Logging::GetDebugOptionName( getCategories()[categoryId] ) : "VERBOSE";
+
+            std::ostringstream os;
+            os << Logging::GetTimeString() << ": [" << categoryName << "]\t" << suppressed << " records were suppressed by the rate limit";
+            return os.str();
+        }
+
+        static void _workerThread( AsyncLogWriter * writer )
+        {
+            std::ostream & output = writer->_output();
+            std::string record;
+
+            while ( true ) {
+                // Read the flag before draining the queue so no record pushed before stop() is lost.
+                const bool isRunning = writer->_isRunning.load( std::memory_order_acquire );
+
+                bool isWritten = false;
+                while ( writer->_queue.pop( record ) ) {
+                    output << record << '\n';
+                    isWritten = true;
+                }
+
+                const uint32_t droppedRecords = writer->_droppedRecords.exchange( 0, std::memory_order_relaxed );
+                if ( droppedRecords > 0 ) {
+                    output << Logging::GetTimeString() << ": [LOG]\t" << droppedRecords << " records were dropped because the queue was full" << '\n';
+                    isWritten = true;
+                }
+
+                if ( isWritten ) {
+                    output.flush();
+                }
+                else if ( !isRunning ) {
+                    break;
+                }
+                else {
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+                }
+            }
+        }
+    };
+
+    AsyncLogWriter asyncLogWriter;
+#endif
 }
 
 namespace Logging
@@ -92,10 +408,18 @@ namespace Logging
     {
         time_t raw;
         std::time( &raw );
-        struct tm * tmi = std::localtime( &raw );
+        // Records can be formatted by several threads at once so the reentrant version of localtime is used.
+        struct tm tmi;
+#if defined( _MSC_VER )
+        localtime_s( &tmi, &raw );
+#elif defined( __MINGW32__ )
+        tmi = *std::localtime( &raw );
+#else
+        localtime_r( &raw, &tmi );
+#endif
 
         char buf[13] = {0};
-        std::strftime( buf, sizeof( buf ) - 1, "%X", tmi );
+        std::strftime( buf, sizeof( buf ) - 1, "%X", &tmi );
 
         return std::string( buf );
     }
@@ -104,6 +428,8 @@ namespace Logging
     {
 #if defined( __SWITCH__ ) // Platforms which log to file
         logFile.open( "fheroes2.log", std::ofstream::out );
+#elif defined( WITH_ASYNC_LOG )
+        asyncLogWriter.start( "fheroes2.log" );
 #endif
     }
 
@@ -111,6 +437,19 @@ namespace Logging
     {
         g_debug = debugLevel;
     }
+
+#if defined( WITH_ASYNC_LOG )
+    bool isAsyncRecordAllowed( const int name )
+    {
+        return asyncLogWriter.isAllowed( name );
+    }
+
+    void pushAsyncRecord( std::string && record )
+    {
+        asyncLogWriter.push( std::move( record ) );
+    }
+
+#endif
 }
 
 bool IS_DEBUG( const int name, const int level )
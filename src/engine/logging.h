@@ -23,6 +23,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <type_traits>
 
 enum
 {
@@ -76,6 +78,16 @@ namespace Logging
     void InitLog();
 
     void SetDebugLevel( const int debugLevel );
+
+#if defined( WITH_ASYNC_LOG )
+    // Returns false if the category of the record has exceeded its rate limit, the record must be skipped then.
+    // Use 0 as a name for records without debug category.
+    bool isAsyncRecordAllowed( const int name );
+
+    // Enqueues an already formatted record to be written by the background writer thread.
+    // All records are written when the application exits.
+    void pushAsyncRecord( std::string && record );
+#endif
 }
 
 #if defined( ANDROID ) // Android has a specific logging function
@@ -120,19 +132,40 @@ namespace Logging
     }
 #endif
 
+// With WITH_ASYNC_LOG defined debug and verbose records are formatted on the calling thread and then written into a file by a background thread.
+// Error records are always written synchronously.
+#if defined( WITH_ASYNC_LOG )
+#define ASYNC_COUT( name, x )                                                                                                                                            \
+    {                                                                                                                                                                    \
+        if ( Logging::isAsyncRecordAllowed( name ) ) {                                                                                                                   \
+            std::ostringstream osss;                                                                                                                                     \
+            osss << x;                                                                                                                                                   \
+            Logging::pushAsyncRecord( osss.str() );                                                                                                                      \
+        }                                                                                                                                                                \
+    }
+#else
+#define ASYNC_COUT( name, x ) COUT( x )
+#endif
+
 #define VERBOSE_LOG( x )                                                                                                                                                 \
     {                                                                                                                                                                    \
-        COUT( Logging::GetTimeString() << ": [VERBOSE]\t" << __FUNCTION__ << ":  " << x );                                                                               \
+        ASYNC_COUT( 0, Logging::GetTimeString() << ": [VERBOSE]\t" << __FUNCTION__ << ":  " << x );                                                                      \
     }
 #define ERROR_LOG( x )                                                                                                                                                   \
     {                                                                                                                                                                    \
         COUT( Logging::GetTimeString() << ": [ERROR]\t" << __FUNCTION__ << ":  " << x );                                                                                 \
     }
 
+// Debug records with a level above DEBUG_LOG_MAX_LEVEL are removed at compile time. The level must be a compile-time constant
+// so the condition is folded by the compiler and such records cost nothing even when debug logging is enabled.
+#ifndef DEBUG_LOG_MAX_LEVEL
+#define DEBUG_LOG_MAX_LEVEL DBG_TRACE
+#endif
+
 #ifdef WITH_DEBUG
 #define DEBUG_LOG( x, y, z )                                                                                                                                             \
-    if ( IS_DEBUG( x, y ) ) {                                                                                                                                            \
-        COUT( Logging::GetTimeString() << ": [" << Logging::GetDebugOptionName( x ) << "]\t" << __FUNCTION__ << ":  " << z );                                            \
+    if ( std::integral_constant<bool, ( ( y ) <= DEBUG_LOG_MAX_LEVEL )>::value && IS_DEBUG( x, y ) ) {                                                                   \
+        ASYNC_COUT( x, Logging::GetTimeString() << ": [" << Logging::GetDebugOptionName( x ) << "]\t" << __FUNCTION__ << ":  " << z );                                   \
     }
 #else
 #define DEBUG_LOG( x, y, z )
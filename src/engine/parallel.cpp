@@ -0,0 +1,113 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "parallel.h"
+#include "rand.h"
+
+namespace
+{
+    thread_local fheroes2::ThreadContext * currentThreadContext = nullptr;
+
+    void processTasks( std::atomic<size_t> & nextTask, const size_t taskCount, const std::function<void( const size_t )> & task )
+    {
+        while ( true ) {
+            const size_t taskId = nextTask.fetch_add( 1 );
+            if ( taskId >= taskCount ) {
+                return;
+            }
+
+            task( taskId );
+        }
+    }
+}
+
+namespace fheroes2
+{
+    ThreadContext * getThreadContext()
+    {
+        return currentThreadContext;
+    }
+
+    void setThreadContext( ThreadContext * context )
+    {
+        currentThreadContext = context;
+    }
+
+    size_t getWorkerThreadCount()
+    {
+        // hardware_concurrency() is allowed to return 0 when the value is not computable.
+        const unsigned int threadCount = std::thread::hardware_concurrency();
+        return threadCount > 0 ? threadCount : 1;
+    }
+
+    void parallelFor( const size_t taskCount, const std::function<void( const size_t )> & task )
+    {
+        if ( taskCount == 0 ) {
+            return;
+        }
+
+        const size_t threadCount = std::min( getWorkerThreadCount(), taskCount );
+        if ( threadCount < 2 ) {
+            for ( size_t i = 0; i < taskCount; ++i ) {
+                task( i );
+            }
+            return;
+        }
+
+        std::atomic<size_t> nextTask( 0 );
+
+        std::vector<std::thread> workers;
+        workers.reserve( threadCount - 1 );
+
+        ThreadContext * context = currentThreadContext;
+
+        for ( size_t i = 1; i < threadCount; ++i ) {
+            workers.emplace_back( [&nextTask, taskCount, &task, context]() {
+                currentThreadContext = context;
+                processTasks( nextTask, taskCount, task );
+            } );
+        }
+
+        processTasks( nextTask, taskCount, task );
+
+        for ( std::thread & worker : workers ) {
+            worker.join();
+        }
+    }
+
+    void parallelForWithSeed( const size_t taskCount, const size_t seed, const std::function<void( const size_t )> & task )
+    {
+        const std::mt19937 callerGenerator = Rand::CurrentThreadRandomDevice();
+
+        parallelFor( taskCount, [seed, &task]( const size_t taskId ) {
+            std::seed_seq taskSeed{ static_cast<uint32_t>( seed ), static_cast<uint32_t>( static_cast<uint64_t>( seed ) >> 32 ), static_cast<uint32_t>( taskId ) };
+            Rand::CurrentThreadRandomDevice().seed( taskSeed );
+
+            task( taskId );
+        } );
+
+        Rand::CurrentThreadRandomDevice() = callerGenerator;
+    }
+}
@@ -0,0 +1,51 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace fheroes2
+{
+    // State which belongs to a thread, for example a game session. Worker threads of parallelFor() execute their tasks with the context of
+    // the calling thread.
+    class ThreadContext
+    {
+    public:
+        virtual ~ThreadContext() = default;
+    };
+
+    ThreadContext * getThreadContext();
+    void setThreadContext( ThreadContext * context );
+
+    // Returns the number of worker threads to be used for CPU bound tasks. It is never less than 1.
+    size_t getWorkerThreadCount();
+
+    // Executes the given task for every index in [0; taskCount) range using a temporary pool of worker threads.
+    // Tasks are distributed dynamically so they could have different complexity. The calling thread participates in the work
+    // and the function returns only when all tasks are finished. Tasks must not access shared data without synchronization.
+    void parallelFor( const size_t taskCount, const std::function<void( const size_t )> & task );
+
+    // Same as parallelFor() but the random generator of the thread is seeded before every task by a value derived from the given seed and
+    // the task index. Random values used by a task do not depend on the number of threads or the order of execution then.
+    // The random generator of the calling thread is restored when all tasks are finished.
+    void parallelForWithSeed( const size_t taskCount, const size_t seed, const std::function<void( const size_t )> & task );
+}
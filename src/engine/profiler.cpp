@@ -0,0 +1,231 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "logging.h"
+#include "profiler.h"
+
+namespace
+{
+    struct ZoneRecord
+    {
+        const char * name;
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+
+    struct ZoneStatistics
+    {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+    };
+
+    const size_t threadBufferSize = 1 << 16;
+
+    // Frames taking longer than this are reported as stalls
+    const uint64_t slowFrameThresholdNs = 100 * 1000 * 1000;
+
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer( const uint32_t threadId )
+            : id( threadId )
+            , records( threadBufferSize )
+        {}
+
+        // The mutex is never contended except while a summary or a trace is being created
+        std::mutex mutex;
+        const uint32_t id;
+        std::vector<ZoneRecord> records;
+
+        // The total number of records ever written. The ring buffer keeps only the last threadBufferSize of them.
+        uint64_t writtenRecords = 0;
+
+        // The value of writtenRecords when the last frame finished
+        uint64_t frameFirstRecord = 0;
+    };
+
+    struct ProfilerData
+    {
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+
+        // Accessed only by the rendering thread
+        uint64_t lastFrameNs = 0;
+    };
+
+    ProfilerData & profilerData()
+    {
+        static ProfilerData data;
+        return data;
+    }
+
+    ThreadBuffer & threadBuffer()
+    {
+        // Buffers are owned by the profiler so zones of already finished threads are still available for reports
+        thread_local ThreadBuffer * buffer = nullptr;
+
+        if ( buffer == nullptr ) {
+            ProfilerData & data = profilerData();
+            std::lock_guard<std::mutex> guard( data.mutex );
+
+            data.buffers.emplace_back( new ThreadBuffer( static_cast<uint32_t>( data.buffers.size() ) ) );
+            buffer = data.buffers.back().get();
+        }
+
+        return *buffer;
+    }
+
+    // Calls the function for every record still kept in the ring buffers. If currentFrameOnly is set only records written since the previous call
+    // with this flag are visited, and the current position of every buffer is remembered as the start of the next frame.
+    template <typename Function>
+    void forEachZone( Function function, const bool currentFrameOnly = false )
+    {
+        ProfilerData & data = profilerData();
+        std::lock_guard<std::mutex> guard( data.mutex );
+
+        for ( const std::unique_ptr<ThreadBuffer> & buffer : data.buffers ) {
+            std::lock_guard<std::mutex> bufferGuard( buffer->mutex );
+
+            uint64_t firstRecord = buffer->writtenRecords - std::min<uint64_t>( buffer->writtenRecords, threadBufferSize );
+            if ( currentFrameOnly ) {
+                firstRecord = std::max( firstRecord, buffer->frameFirstRecord );
+                buffer->frameFirstRecord = buffer->writtenRecords;
+            }
+
+            for ( uint64_t i = firstRecord; i < buffer->writtenRecords; ++i ) {
+                function( buffer->id, buffer->records[i % threadBufferSize] );
+            }
+        }
+    }
+
+    void logZoneSummary( const std::string & title, const uint64_t fromNs, const uint64_t toNs, const uint64_t minDurationNs, const bool currentFrameOnly )
+    {
+        std::map<std::string, ZoneStatistics> statistics;
+        uint64_t maxDurationNs = 0;
+
+        forEachZone(
+            [&]( const uint32_t, const ZoneRecord & record ) {
+                if ( record.startNs < fromNs || record.startNs > toNs )
+                    return;
+
+                const uint64_t durationNs = record.endNs - record.startNs;
+
+                ZoneStatistics & zone = statistics[record.name];
+                ++zone.count;
+                zone.totalNs += durationNs;
+                zone.maxNs = std::max( zone.maxNs, durationNs );
+
+                maxDurationNs = std::max( maxDurationNs, durationNs );
+            },
+            currentFrameOnly );
+
+        if ( statistics.empty() || maxDurationNs < minDurationNs )
+            return;
+
+        std::vector<std::pair<std::string, ZoneStatistics> > zones( statistics.begin(), statistics.end() );
+        std::sort( zones.begin(), zones.end(), []( const std::pair<std::string, ZoneStatistics> & first, const std::pair<std::string, ZoneStatistics> & second ) {
+            return first.second.totalNs > second.second.totalNs;
+        } );
+
+        std::ostringstream os;
+        os << std::fixed << std::setprecision( 3 ) << title << " took " << ( toNs - fromNs ) / 1e6 << " ms";
+
+        for ( const std::pair<std::string, ZoneStatistics> & zone : zones ) {
+            os << std::endl
+               << "    " << zone.first << ": calls " << zone.second.count << ", total " << zone.second.totalNs / 1e6 << " ms, max " << zone.second.maxNs / 1e6 << " ms";
+        }
+
+        VERBOSE_LOG( os.str() )
+    }
+}
+
+namespace fheroes2
+{
+    namespace Profiler
+    {
+        uint64_t now()
+        {
+            const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - profilerData().startTime;
+            return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count() );
+        }
+
+        void addZone( const char * name, const uint64_t startNs, const uint64_t endNs )
+        {
+            ThreadBuffer & buffer = threadBuffer();
+            std::lock_guard<std::mutex> guard( buffer.mutex );
+
+            buffer.records[buffer.writtenRecords % threadBufferSize] = { name, startNs, endNs };
+            ++buffer.writtenRecords;
+        }
+
+        void logSummary( const std::string & title, const uint64_t fromNs, const uint64_t toNs, const uint64_t minDurationNs )
+        {
+            logZoneSummary( title, fromNs, toNs, minDurationNs, false );
+        }
+
+        void frameFinished()
+        {
+            ProfilerData & data = profilerData();
+            const uint64_t currentNs = now();
+
+            // Only zones recorded since the previous frame are scanned instead of whole ring buffers
+            logZoneSummary( "Slow frame", data.lastFrameNs, currentNs, slowFrameThresholdNs, true );
+
+            data.lastFrameNs = currentNs;
+        }
+
+        bool saveChromeTrace( const std::string & path )
+        {
+            std::ofstream file( path.c_str() );
+            if ( !file ) {
+                ERROR_LOG( "Unable to open " << path << " to save profiler trace." )
+                return false;
+            }
+
+            file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+            bool isFirstEvent = true;
+            file << std::fixed << std::setprecision( 3 );
+
+            forEachZone( [&]( const uint32_t threadId, const ZoneRecord & record ) {
+                file << ( isFirstEvent ? "" : "," ) << std::endl
+                     << "{\"name\":\"" << record.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId << ",\"ts\":" << record.startNs / 1e3
+                     << ",\"dur\":" << ( record.endNs - record.startNs ) / 1e3 << "}";
+                isFirstEvent = false;
+            } );
+
+            file << std::endl << "]}" << std::endl;
+
+            return file.good();
+        }
+    }
+}
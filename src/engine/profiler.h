@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Scoped profiler zones are compiled only when WITH_PROFILER is defined. Otherwise the macros below expand to nothing.
+#ifdef WITH_PROFILER
+#define PROFILER_CONCATENATE_IMPL( x, y ) x##y
+#define PROFILER_CONCATENATE( x, y ) PROFILER_CONCATENATE_IMPL( x, y )
+// Measures the time spent in the current scope. The name must be a string literal.
+#define PROFILE_ZONE( name ) const fheroes2::ProfilerZone PROFILER_CONCATENATE( profilerZone, __LINE__ )( name )
+// Logs a summary of all zones recorded by any thread within the current scope once the scope is left.
+#define PROFILE_REPORT( title ) const fheroes2::ProfilerReport PROFILER_CONCATENATE( profilerReport, __LINE__ )( title )
+#else
+#define PROFILE_ZONE( name )
+#define PROFILE_REPORT( title )
+#endif
+
+namespace fheroes2
+{
+    namespace Profiler
+    {
+        // Returns time in nanoseconds since the profiler start.
+        uint64_t now();
+
+        // Every thread stores its zones in its own ring buffer so the oldest zones are overwritten once the buffer is full.
+        void addZone( const char * name, const uint64_t startNs, const uint64_t endNs );
+
+        // Logs the number of calls, total and maximal time of every zone started within the given time range.
+        // Nothing is logged if no zone took at least minDurationNs.
+        void logSummary( const std::string & title, const uint64_t fromNs, const uint64_t toNs, const uint64_t minDurationNs = 0 );
+
+        // Must be called once per rendered frame. Logs a summary for frames which took too long.
+        void frameFinished();
+
+        // Saves all recorded zones in Chrome trace event format which can be opened by chrome://tracing or Perfetto.
+        bool saveChromeTrace( const std::string & path );
+    }
+
+    class ProfilerZone
+    {
+    public:
+        explicit ProfilerZone( const char * name )
+            : _name( name )
+            , _startNs( Profiler::now() )
+        {}
+
+        ProfilerZone( const ProfilerZone & ) = delete;
+        ProfilerZone & operator=( const ProfilerZone & ) = delete;
+
+        ~ProfilerZone()
+        {
+            Profiler::addZone( _name, _startNs, Profiler::now() );
+        }
+
+    private:
+        const char * _name;
+        const uint64_t _startNs;
+    };
+
+    class ProfilerReport
+    {
+    public:
+        explicit ProfilerReport( std::string title )
+            : _title( std::move( title ) )
+            , _startNs( Profiler::now() )
+        {}
+
+        ProfilerReport( const ProfilerReport & ) = delete;
+        ProfilerReport & operator=( const ProfilerReport & ) = delete;
+
+        ~ProfilerReport()
+        {
+            Profiler::logSummary( _title, _startNs, Profiler::now() );
+        }
+
+    private:
+        const std::string _title;
+        const uint64_t _startNs;
+    };
+}
@@ -24,6 +24,7 @@
 
 #include "logging.h"
 #include "rand.h"
+#include "tools.h"
 
 std::mt19937 & Rand::CurrentThreadRandomDevice()
 {
@@ -145,3 +146,22 @@ uint32_t Rand::DeterministicRandomGenerator::Get( const uint32_t from, const uin
     ++_currentSeed;
     return Rand::GetWithSeed( from, to, static_cast<uint32_t>( _currentSeed ) );
 }
+
+Rand::DeterministicRandomContext::DeterministicRandomContext( const size_t streamCount )
+{
+    _streams.reserve( streamCount );
+
+    for ( size_t i = 0; i < streamCount; ++i ) {
+        _streams.emplace_back( new DeterministicRandomGenerator( 0 ) );
+    }
+}
+
+void Rand::DeterministicRandomContext::Reset( const size_t seed )
+{
+    for ( size_t i = 0; i < _streams.size(); ++i ) {
+        size_t streamSeed = seed;
+        fheroes2::hashCombine( streamSeed, i );
+
+        _streams[i]->UpdateSeed( streamSeed );
+    }
+}
@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include <functional>
 #include <list>
+#include <memory>
 #include <random>
 #include <utility>
 #include <vector>
@@ -145,6 +146,40 @@ namespace Rand
     private:
         mutable size_t _currentSeed; // this is mutable so clients that only call RNG method can receive a const instance
     };
+
+    // Set of independent deterministic generators derived from a single seed, one generator per subsystem.
+    // Random calls made by one subsystem do not shift the results of another one.
+    class DeterministicRandomContext
+    {
+    public:
+        explicit DeterministicRandomContext( const size_t streamCount );
+
+        DeterministicRandomContext( const DeterministicRandomContext & ) = delete;
+        DeterministicRandomContext & operator=( const DeterministicRandomContext & ) = delete;
+
+        // Derives the initial seed of every stream from the given seed and the stream id.
+        void Reset( const size_t seed );
+
+        size_t Count() const
+        {
+            return _streams.size();
+        }
+
+        const DeterministicRandomGenerator & Get( const size_t stream ) const
+        {
+            assert( stream < _streams.size() );
+            return *_streams[stream];
+        }
+
+        void UpdateSeed( const size_t stream, const size_t seed )
+        {
+            assert( stream < _streams.size() );
+            _streams[stream]->UpdateSeed( seed );
+        }
+
+    private:
+        std::vector<std::unique_ptr<DeterministicRandomGenerator>> _streams;
+    };
 }
 
 #endif
@@ -20,6 +20,7 @@
 
 #include "screen.h"
 #include "image_palette.h"
+#include "profiler.h"
 #include "tools.h"
 
 #include <SDL_version.h>
@@ -814,6 +815,9 @@ namespace
 
         void clear() override
         {
+            _isColorChanged.clear();
+            _frameCopy.clear();
+
             if ( _texture != nullptr ) {
                 SDL_DestroyTexture( _texture );
                 _texture = nullptr;
@@ -848,7 +852,12 @@ namespace
             if ( _surface == nullptr )
                 return;
 
-            copyImageToSurface( display, _surface, roi );
+            if ( _surface->format->BitsPerPixel == 32 ) {
+                _copyImageToFrame( display, roi );
+            }
+            else {
+                copyImageToSurface( display, _surface, roi );
+            }
 
             if ( _texture == nullptr ) {
                 if ( _renderer != nullptr )
@@ -859,6 +868,11 @@ namespace
             else {
                 const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
                 if ( fullFrame ) {
+                    if ( _surface->format->BitsPerPixel == 32 ) {
+                        // The frame copy is complete now so next palette updates can be applied to it.
+                        _isColorChanged.assign( 256, 0 );
+                    }
+
                     SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
                     if ( SDL_SetRenderTarget( _renderer, nullptr ) == 0 ) {
                         if ( SDL_RenderClear( _renderer ) == 0 && SDL_RenderCopy( _renderer, _texture, nullptr, nullptr ) == 0 ) {
@@ -867,18 +881,71 @@ namespace
                     }
                 }
                 else {
-                    SDL_Rect area;
-                    area.x = roi.x;
-                    area.y = roi.y;
-                    area.w = roi.width;
-                    area.h = roi.height;
-
-                    SDL_UpdateTexture( _texture, &area, _surface->pixels, _surface->pitch );
-                    if ( SDL_SetRenderTarget( _renderer, nullptr ) == 0 && SDL_RenderCopy( _renderer, _texture, nullptr, nullptr ) == 0 ) {
-                        SDL_RenderPresent( _renderer );
+                    _updateTexture( roi );
+                }
+            }
+        }
+
+        bool renderPaletteUpdate( const fheroes2::Display & display, const fheroes2::Rect & /*roi*/ ) override
+        {
+            // The frame copy is valid only after a full frame render.
+            if ( _surface == nullptr || _texture == nullptr || _surface->format->BitsPerPixel != 32 || _isColorChanged.empty() )
+                return false;
+
+            const int32_t width = display.width();
+            const int32_t height = display.height();
+
+            if ( SDL_MUSTLOCK( _surface ) || _frameCopy.size() != static_cast<size_t>( width * height ) ) {
+                // The frame copy must stay the same between renders. This is not guaranteed for surfaces requiring locking.
+                return false;
+            }
+
+            // The requested area is not converted as a whole: the image is compared with the frame which was converted last time so only pixels
+            // of changed colors and pixels drawn since the last render (mouse cursor, system info) are converted and uploaded.
+            const uint8_t * isColorChanged = _isColorChanged.data();
+            const uint32_t * transform = _palette32Bit.data();
+
+            int32_t minX = width;
+            int32_t maxX = -1;
+            int32_t minY = height;
+            int32_t maxY = -1;
+
+            const uint8_t * inY = display.image();
+            uint8_t * prevY = _frameCopy.data();
+            uint8_t * outY = static_cast<uint8_t *>( _surface->pixels );
+
+            for ( int32_t y = 0; y < height; ++y, inY += width, prevY += width, outY += _surface->pitch ) {
+                uint32_t * out = reinterpret_cast<uint32_t *>( outY );
+                bool isRowChanged = false;
+
+                for ( int32_t x = 0; x < width; ++x ) {
+                    const uint8_t colorId = inY[x];
+                    if ( isColorChanged[colorId] || colorId != prevY[x] ) {
+                        out[x] = transform[colorId];
+                        prevY[x] = colorId;
+
+                        if ( x < minX )
+                            minX = x;
+                        if ( x > maxX )
+                            maxX = x;
+                        isRowChanged = true;
                     }
                 }
+
+                if ( isRowChanged ) {
+                    if ( y < minY )
+                        minY = y;
+                    maxY = y;
+                }
             }
+
+            std::fill( _isColorChanged.begin(), _isColorChanged.end(), static_cast<uint8_t>( 0 ) );
+
+            if ( maxY >= 0 ) {
+                _updateTexture( fheroes2::Rect( minX, minY, maxX - minX + 1, maxY - minY + 1 ) );
+            }
+
+            return true;
         }
 
         bool allocate( int32_t & width_, int32_t & height_, bool isFullScreen ) override
@@ -966,10 +1033,20 @@ namespace
             if ( _surface == nullptr || colorIds.size() != 256 )
                 return;
 
+            const std::vector<uint32_t> prevPalette32Bit( _palette32Bit );
+
             generatePalette( colorIds, _surface );
             if ( _surface->format->BitsPerPixel == 8 ) {
                 SDL_SetPaletteColors( _surface->format->palette, _palette8Bit.data(), 0, 256 );
             }
+            else if ( !_isColorChanged.empty() && prevPalette32Bit.size() == _palette32Bit.size() ) {
+                // Colors changed since the last full frame render are accumulated to be updated by renderPaletteUpdate().
+                for ( size_t i = 0; i < 256; ++i ) {
+                    if ( prevPalette32Bit[i] != _palette32Bit[i] ) {
+                        _isColorChanged[i] = 1;
+                    }
+                }
+            }
         }
 
         bool isMouseCursorActive() const override
@@ -983,6 +1060,12 @@ namespace
         SDL_Renderer * _renderer;
         SDL_Texture * _texture;
 
+        // For 32-bit surface: palette entries changed since the last full frame render. Empty if the surface doesn't contain a full frame yet.
+        std::vector<uint8_t> _isColorChanged;
+
+        // For 32-bit surface: the image which the surface content was converted from. Empty if the surface doesn't contain a full frame yet.
+        std::vector<uint8_t> _frameCopy;
+
         std::string _previousWindowTitle;
         fheroes2::Point _prevWindowPos;
         fheroes2::Size _currentScreenResolution;
@@ -1024,6 +1107,61 @@ namespace
             }
         }
 
+        // Unlike copyImageToSurface() the surface keeps the whole converted frame so the area is written at its place.
+        void _copyImageToFrame( const fheroes2::Image & image, const fheroes2::Rect & roi )
+        {
+            assert( _surface != nullptr && _surface->format->BitsPerPixel == 32 && !image.empty() );
+
+            if ( SDL_MUSTLOCK( _surface ) )
+                SDL_LockSurface( _surface );
+
+            const int32_t imageWidth = image.width();
+            const uint8_t * inY = image.image() + roi.x + roi.y * imageWidth;
+            uint8_t * outY = static_cast<uint8_t *>( _surface->pixels ) + roi.y * _surface->pitch + roi.x * 4;
+            const uint32_t * transform = _palette32Bit.data();
+
+            for ( int32_t y = 0; y < roi.height; ++y, inY += imageWidth, outY += _surface->pitch ) {
+                uint32_t * outX = reinterpret_cast<uint32_t *>( outY );
+                const uint32_t * outXEnd = outX + roi.width;
+                const uint8_t * inX = inY;
+
+                for ( ; outX != outXEnd; ++outX, ++inX )
+                    *outX = *( transform + *inX );
+            }
+
+            const size_t imageSize = static_cast<size_t>( imageWidth * image.height() );
+            if ( roi.width == imageWidth && roi.height == image.height() ) {
+                _frameCopy.assign( image.image(), image.image() + imageSize );
+            }
+            else if ( _frameCopy.size() == imageSize ) {
+                inY = image.image() + roi.x + roi.y * imageWidth;
+                uint8_t * copyY = _frameCopy.data() + roi.x + roi.y * imageWidth;
+
+                for ( int32_t y = 0; y < roi.height; ++y, inY += imageWidth, copyY += imageWidth ) {
+                    memcpy( copyY, inY, static_cast<size_t>( roi.width ) );
+                }
+            }
+
+            if ( SDL_MUSTLOCK( _surface ) )
+                SDL_UnlockSurface( _surface );
+        }
+
+        void _updateTexture( const fheroes2::Rect & roi )
+        {
+            SDL_Rect area;
+            area.x = roi.x;
+            area.y = roi.y;
+            area.w = roi.width;
+            area.h = roi.height;
+
+            const uint8_t * pixels = static_cast<const uint8_t *>( _surface->pixels ) + roi.y * _surface->pitch + roi.x * _surface->format->BytesPerPixel;
+
+            SDL_UpdateTexture( _texture, &area, pixels, _surface->pitch );
+            if ( SDL_SetRenderTarget( _renderer, nullptr ) == 0 && SDL_RenderCopy( _renderer, _texture, nullptr, nullptr ) == 0 ) {
+                SDL_RenderPresent( _renderer );
+            }
+        }
+
         void _retrieveWindowInfo()
         {
             const int32_t displayIndex = SDL_GetWindowDisplayIndex( _window );
@@ -1318,6 +1456,12 @@ namespace fheroes2
 
     void Display::render( const Rect & roi )
     {
+#ifdef WITH_PROFILER
+        // Every rendering closes the previous frame
+        Profiler::frameFinished();
+#endif
+        PROFILE_ZONE( "Display::render" );
+
         Rect temp( roi );
         if ( !getActiveArea( temp, width(), height() ) )
             return;
@@ -1367,8 +1511,10 @@ namespace fheroes2
                 // when we change a palette for 8-bit image we unwillingly call render so we don't need to re-render the same frame again
                 updateImage = ( _renderSurface == nullptr );
                 if ( updateImage ) {
-                    // Pre-processing step is applied to the whole image so we forcefully render the full frame.
-                    _engine->render( *this, Rect( 0, 0, width(), height() ) );
+                    if ( !_engine->renderPaletteUpdate( *this, roi ) ) {
+                        // Pre-processing step is applied to the whole image so we forcefully render the full frame.
+                        _engine->render( *this, Rect( 0, 0, width(), height() ) );
+                    }
                     return;
                 }
             }
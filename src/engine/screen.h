@@ -107,6 +107,13 @@ namespace fheroes2
             // Do nothing.
         }
 
+        // Render a frame after palette update. Engines keeping a converted copy of the frame can update only pixels of changed colors.
+        // Return false if the full frame must be rendered instead.
+        virtual bool renderPaletteUpdate( const Display &, const Rect & )
+        {
+            return false;
+        }
+
         void linkRenderSurface( uint8_t * surface ) const; // declaration of this method is in source file
 
     private:
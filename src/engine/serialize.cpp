@@ -21,6 +21,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <string>
 
@@ -449,8 +450,22 @@ std::vector<u8> StreamBuf::getRaw( size_t sz )
 
 void StreamBuf::putRaw( const char * ptr, size_t sz )
 {
-    for ( size_t it = 0; it < sz; ++it )
-        *this << ptr[it];
+    if ( sz == 0 )
+        return;
+
+    if ( sizep() < sz )
+        reallocbuf( capacity() + std::max( sz, capacity() / 2 ) );
+
+    if ( sizep() < sz ) {
+        // reallocbuf() always provides enough space, never drop the data silently
+        assert( 0 );
+        ERROR_LOG( "not enough space in the stream buffer to put " << sz << " bytes" )
+        setfail( true );
+        return;
+    }
+
+    memcpy( itput, ptr, sz );
+    itput += sz;
 }
 
 std::string StreamBuf::toString( size_t sz )
@@ -235,3 +235,114 @@ const std::vector<std::vector<uint8_t> > & SMKVideoSequence::getAudioChannels()
 {
     return _audioChannel;
 }
+
+SMKVideoFrameQueue::SMKVideoFrameQueue( SMKVideoSequence & video, const size_t capacity, const bool isLooped )
+    : _video( video )
+    , _isLooped( isLooped )
+    , _frames( std::max( capacity, static_cast<size_t>( 1 ) ) )
+    , _readPos( 0 )
+    , _frameCount( 0 )
+    , _isFinished( false )
+    , _stopFlag( false )
+{
+    for ( Frame & frame : _frames ) {
+        frame.image._disableTransformLayer();
+        frame.image.resize( _video.width(), _video.height() );
+    }
+
+    _worker.reset( new std::thread( SMKVideoFrameQueue::_workerThread, this ) );
+}
+
+SMKVideoFrameQueue::~SMKVideoFrameQueue()
+{
+    {
+        std::lock_guard<std::mutex> guard( _mutex );
+        _stopFlag = true;
+    }
+
+    _frameConsumed.notify_one();
+    _worker->join();
+}
+
+bool SMKVideoFrameQueue::getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette )
+{
+    std::unique_lock<std::mutex> mutexLock( _mutex );
+    _frameDecoded.wait( mutexLock, [this] { return _frameCount > 0 || _isFinished; } );
+
+    if ( _frameCount == 0 ) {
+        width = 0;
+        height = 0;
+        return false;
+    }
+
+    // The frame at the read position is not touched by the worker until it is consumed so it can be copied without holding the lock.
+    const Frame & frame = _frames[_readPos];
+    mutexLock.unlock();
+
+    if ( image.empty() || x < 0 || y < 0 || x >= image.width() || y >= image.height() || !image.singleLayer() ) {
+        width = 0;
+        height = 0;
+    }
+    else {
+        width = std::min( frame.image.width(), image.width() - x );
+        height = std::min( frame.image.height(), image.height() - y );
+
+        fheroes2::Copy( frame.image, 0, 0, image, x, y, width, height );
+        palette = frame.palette;
+    }
+
+    mutexLock.lock();
+    _readPos = ( _readPos + 1 ) % _frames.size();
+    --_frameCount;
+    mutexLock.unlock();
+
+    _frameConsumed.notify_one();
+
+    return true;
+}
+
+void SMKVideoFrameQueue::_workerThread( SMKVideoFrameQueue * queue )
+{
+    SMKVideoSequence & video = queue->_video;
+
+    while ( true ) {
+        size_t writePos = 0;
+
+        {
+            std::unique_lock<std::mutex> mutexLock( queue->_mutex );
+            queue->_frameConsumed.wait( mutexLock, [queue] { return queue->_stopFlag || queue->_frameCount < queue->_frames.size(); } );
+
+            if ( queue->_stopFlag )
+                return;
+
+            writePos = ( queue->_readPos + queue->_frameCount ) % queue->_frames.size();
+        }
+
+        if ( queue->_isLooped && video.getCurrentFrame() >= video.frameCount() ) {
+            video.resetFrame();
+        }
+
+        Frame & frame = queue->_frames[writePos];
+        int32_t width = 0;
+        int32_t height = 0;
+
+        if ( video.getCurrentFrame() < video.frameCount() ) {
+            video.getNextFrame( frame.image, 0, 0, width, height, frame.palette );
+        }
+
+        {
+            std::lock_guard<std::mutex> guard( queue->_mutex );
+
+            // A frame of zero size means either the end of a video or a broken file.
+            if ( width == 0 || height == 0 )
+                queue->_isFinished = true;
+            else
+                ++queue->_frameCount;
+        }
+
+        queue->_frameDecoded.notify_one();
+
+        if ( width == 0 || height == 0 )
+            return;
+    }
+}
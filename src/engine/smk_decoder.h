@@ -20,15 +20,16 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
-struct smk_t;
+#include "image.h"
 
-namespace fheroes2
-{
-    class Image;
-}
+struct smk_t;
 
 class SMKVideoSequence
 {
@@ -69,3 +70,43 @@ private:
 
     struct smk_t * _videoFile;
 };
+
+// Decodes frames of a video sequence ahead of time on a separate thread and keeps them in a bounded ring buffer
+// so the caller only has to copy a ready frame to the screen when its time comes.
+// The video sequence must not be accessed by anyone else while the queue exists.
+class SMKVideoFrameQueue
+{
+public:
+    SMKVideoFrameQueue( SMKVideoSequence & video, const size_t capacity, const bool isLooped );
+    ~SMKVideoFrameQueue();
+
+    SMKVideoFrameQueue( const SMKVideoFrameQueue & ) = delete;
+    SMKVideoFrameQueue & operator=( const SMKVideoFrameQueue & ) = delete;
+
+    // Same as SMKVideoSequence::getNextFrame() but waits until the next frame is decoded.
+    // Returns false if there are no more frames in a non-looped video.
+    bool getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette );
+
+private:
+    struct Frame
+    {
+        fheroes2::Image image;
+        std::vector<uint8_t> palette;
+    };
+
+    static void _workerThread( SMKVideoFrameQueue * queue );
+
+    SMKVideoSequence & _video;
+    const bool _isLooped;
+
+    std::vector<Frame> _frames;
+    size_t _readPos;
+    size_t _frameCount;
+    bool _isFinished;
+    bool _stopFlag;
+
+    std::mutex _mutex;
+    std::condition_variable _frameDecoded;
+    std::condition_variable _frameConsumed;
+    std::unique_ptr<std::thread> _worker;
+};
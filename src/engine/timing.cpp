@@ -20,10 +20,28 @@
 
 #include "timing.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
 #include <thread>
 
 #include <SDL.h>
 
+namespace
+{
+    // Time until the nearest not passed TimeDelay. It is reset every time when the event loop picks it up.
+    std::atomic<uint64_t> nearestAnimationDeadlineMs( std::numeric_limits<uint64_t>::max() );
+
+    void reportAnimationDeadline( const uint64_t remainingMs )
+    {
+        uint64_t current = nearestAnimationDeadlineMs.load( std::memory_order_relaxed );
+        while ( remainingMs < current && !nearestAnimationDeadlineMs.compare_exchange_weak( current, remainingMs, std::memory_order_relaxed ) ) {
+            // Do nothing.
+        }
+    }
+}
+
 namespace fheroes2
 {
     struct TimerImp
@@ -90,7 +108,12 @@ namespace fheroes2
     {
         const std::chrono::duration<double> time = std::chrono::steady_clock::now() - _prevTime;
         const uint64_t passedMs = static_cast<uint64_t>( time.count() * 1000 + 0.5 );
-        return passedMs >= delayMs;
+        if ( passedMs >= delayMs ) {
+            return true;
+        }
+
+        reportAnimationDeadline( delayMs - passedMs );
+        return false;
     }
 
     void TimeDelay::reset()
@@ -129,8 +152,44 @@ namespace fheroes2
         _timer->remove();
     }
 
+    FrameTimeStatistics::FrameTimeStatistics( const size_t windowSize )
+        : _frameTimeMs( windowSize, 0 )
+        , _nextFrameId( 0 )
+        , _totalFrames( 0 )
+    {
+        assert( windowSize > 0 );
+    }
+
+    void FrameTimeStatistics::addFrame( const double frameTimeMs )
+    {
+        _frameTimeMs[_nextFrameId] = frameTimeMs;
+        _nextFrameId = ( _nextFrameId + 1 ) % _frameTimeMs.size();
+        ++_totalFrames;
+    }
+
+    double FrameTimeStatistics::getPercentile( const double percentile ) const
+    {
+        const size_t frames = std::min( _totalFrames, _frameTimeMs.size() );
+        if ( frames == 0 ) {
+            return 0;
+        }
+
+        // Until the window is filled up recorded frames occupy its beginning.
+        std::vector<double> sorted( _frameTimeMs.begin(), _frameTimeMs.begin() + static_cast<std::ptrdiff_t>( frames ) );
+        const double position = std::max( 0.0, std::min( percentile, 100.0 ) ) / 100.0 * static_cast<double>( frames - 1 );
+        const std::vector<double>::iterator nth = sorted.begin() + static_cast<std::ptrdiff_t>( position + 0.5 );
+        std::nth_element( sorted.begin(), nth, sorted.end() );
+        return *nth;
+    }
+
     void delayforMs( const uint32_t delayMs )
     {
         std::this_thread::sleep_for( std::chrono::milliseconds( delayMs ) );
     }
+
+    uint64_t getAnimationDeadline( const uint64_t maxDelayMs )
+    {
+        const uint64_t deadlineMs = nearestAnimationDeadlineMs.exchange( std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed );
+        return std::min( deadlineMs, maxDelayMs );
+    }
 }
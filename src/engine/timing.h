@@ -22,6 +22,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
@@ -50,6 +51,7 @@ namespace fheroes2
 
         void setDelay( const uint64_t delayMs );
 
+        // Every check which is not passed yet reports the remaining time as an animation deadline (see getAnimationDeadline()).
         bool isPassed() const;
         bool isPassed( const uint64_t delayMs ) const;
 
@@ -83,5 +85,31 @@ namespace fheroes2
         TimerImp * _timer;
     };
 
+    // Frame time statistics over a sliding window of the most recent frames.
+    class FrameTimeStatistics
+    {
+    public:
+        explicit FrameTimeStatistics( const size_t windowSize );
+
+        void addFrame( const double frameTimeMs );
+
+        // Returns frame time in milliseconds for the given percentile in [0; 100] range or 0 if no frames were recorded.
+        double getPercentile( const double percentile ) const;
+
+        size_t frameCount() const
+        {
+            return _totalFrames;
+        }
+
+    private:
+        std::vector<double> _frameTimeMs;
+        size_t _nextFrameId;
+        size_t _totalFrames;
+    };
+
     void delayforMs( const uint32_t delayMs );
+
+    // Returns the time in milliseconds until the nearest deadline of TimeDelay checked since the previous call but no more than maxDelayMs.
+    // The event loop uses this value to wait for events instead of polling them.
+    uint64_t getAnimationDeadline( const uint64_t maxDelayMs );
 }
@@ -30,7 +30,9 @@
 
 #include "agg.h"
 #include "agg_file.h"
+#include "agg_image.h"
 #include "audio.h"
+#include "cache_tracker.h"
 #include "dir.h"
 #include "embedded_image.h"
 #include "game.h"
@@ -68,12 +70,28 @@ namespace AGG
 
     std::map<int, std::vector<u8>> wav_cache;
     std::map<int, std::vector<u8>> mid_cache;
+
+    // Sound and music caches are accessed only under AsyncSoundManager::resourceMutex().
+    fheroes2::CacheTracker wav_cache_tracker( M82::UNKNOWN + 1 );
+    fheroes2::CacheTracker mid_cache_tracker( XMI::MIDI_ORIGINAL_NECROMANCER + 1 );
+
+    // Release the least recently used entries of a cache to fit its limit. The entry which was just requested is always kept.
+    void ReleaseUnusedEntries( std::map<int, std::vector<u8>> & cache, fheroes2::CacheTracker & tracker, const int requestedId )
+    {
+        const std::vector<size_t> evictionList = tracker.getEvictionList( [requestedId]( const size_t key ) { return key == static_cast<size_t>( requestedId ); } );
+
+        for ( const size_t key : evictionList ) {
+            cache.erase( static_cast<int>( key ) );
+            tracker.release( key );
+        }
+    }
     std::vector<loop_sound_t> loop_sounds;
 
     const std::vector<u8> & GetWAV( int m82 );
     const std::vector<u8> & GetMID( int xmi );
 
     void LoadWAV( int m82, std::vector<u8> & );
+    int PlayWAV( const int m82, const bool loop );
     void LoadMID( int xmi, std::vector<u8> & );
 
     bool ReadDataDir( void );
@@ -408,21 +426,93 @@ void AGG::LoadMID( int xmi, std::vector<u8> & v )
 /* return CVT */
 const std::vector<u8> & AGG::GetWAV( int m82 )
 {
+    assert( m82 >= 0 && m82 <= M82::UNKNOWN );
+
     std::vector<u8> & v = wav_cache[m82];
-    if ( Audio::isValid() && v.empty() )
+    if ( !v.empty() ) {
+        wav_cache_tracker.hit( static_cast<size_t>( m82 ) );
+    }
+    else if ( Audio::isValid() ) {
         LoadWAV( m82, v );
+
+        wav_cache_tracker.miss( static_cast<size_t>( m82 ) );
+        wav_cache_tracker.setSize( static_cast<size_t>( m82 ), v.size() );
+        ReleaseUnusedEntries( wav_cache, wav_cache_tracker, m82 );
+    }
     return v;
 }
 
 /* return MID */
 const std::vector<u8> & AGG::GetMID( int xmi )
 {
+    assert( xmi >= 0 && xmi <= XMI::MIDI_ORIGINAL_NECROMANCER );
+
     std::vector<u8> & v = mid_cache[xmi];
-    if ( Audio::isValid() && v.empty() )
+    if ( !v.empty() ) {
+        mid_cache_tracker.hit( static_cast<size_t>( xmi ) );
+    }
+    else if ( Audio::isValid() ) {
         LoadMID( xmi, v );
+
+        mid_cache_tracker.miss( static_cast<size_t>( xmi ) );
+        mid_cache_tracker.setSize( static_cast<size_t>( xmi ), v.size() );
+        ReleaseUnusedEntries( mid_cache, mid_cache_tracker, xmi );
+    }
     return v;
 }
 
+int AGG::PlayWAV( const int m82, const bool loop )
+{
+    // Sounds converted into the audio device format are cached by the mixer so the original data is needed only once.
+    if ( Mixer::isCached( m82 ) ) {
+        return Mixer::PlayCached( m82, nullptr, 0, -1, loop );
+    }
+
+    const std::vector<u8> & v = GetWAV( m82 );
+    if ( v.empty() ) {
+        return -1;
+    }
+
+    const int channel = Mixer::PlayCached( m82, v.data(), static_cast<uint32_t>( v.size() ), -1, loop );
+
+    // The mixer keeps its own converted copy of the sound so the original data is not needed anymore.
+    if ( Mixer::isCached( m82 ) ) {
+        wav_cache.erase( m82 );
+        wav_cache_tracker.release( static_cast<size_t>( m82 ) );
+    }
+
+    return channel;
+}
+
+void AGG::SetSoundCacheLimit( const size_t bytes )
+{
+    std::lock_guard<std::mutex> mutexLock( g_asyncSoundManager.resourceMutex() );
+
+    // Converted sounds are several times bigger than the original data which is kept only until the conversion.
+    Mixer::SetCacheLimit( bytes / 4 * 3 );
+    wav_cache_tracker.setLimit( bytes / 8 );
+    mid_cache_tracker.setLimit( bytes / 8 );
+}
+
+fheroes2::CacheStatistics AGG::GetSoundCacheStatistics()
+{
+    std::lock_guard<std::mutex> mutexLock( g_asyncSoundManager.resourceMutex() );
+
+    fheroes2::CacheStatistics statistics = Mixer::GetCacheStatistics();
+
+    for ( const fheroes2::CacheTracker * tracker : { &wav_cache_tracker, &mid_cache_tracker } ) {
+        const fheroes2::CacheStatistics & trackerStatistics = tracker->statistics();
+
+        statistics.hits += trackerStatistics.hits;
+        statistics.misses += trackerStatistics.misses;
+        statistics.evictions += trackerStatistics.evictions;
+        statistics.usedBytes += trackerStatistics.usedBytes;
+        statistics.limitBytes += trackerStatistics.limitBytes;
+    }
+
+    return statistics;
+}
+
 void AGG::LoadLOOPXXSounds( const std::vector<int> & vols, bool asyncronizedCall )
 {
     if ( vols.empty() ) {
@@ -476,8 +566,7 @@ void AGG::LoadLOOPXXSoundsInternally( const std::vector<int> & vols, const int s
         else
             // new sound
             if ( 0 != vol ) {
-            const std::vector<u8> & v = GetWAV( m82 );
-            const int ch = Mixer::Play( &v[0], static_cast<uint32_t>( v.size() ), -1, true );
+            const int ch = PlayWAV( m82, true );
 
             if ( 0 <= ch ) {
                 Mixer::Pause( ch );
@@ -522,8 +611,7 @@ void AGG::PlaySoundInternally( const int m82, const int soundVolume )
 
     DEBUG_LOG( DBG_ENGINE, DBG_TRACE, M82::GetString( m82 ) );
 
-    const std::vector<u8> & v = AGG::GetWAV( m82 );
-    const int ch = Mixer::Play( &v[0], static_cast<uint32_t>( v.size() ), -1, false );
+    const int ch = PlayWAV( m82, false );
 
     if ( ch >= 0 ) {
         Mixer::Pause( ch );
@@ -667,6 +755,9 @@ AGG::AGGInitializer::AGGInitializer()
 
 AGG::AGGInitializer::~AGGInitializer()
 {
+    DEBUG_LOG( DBG_ENGINE, DBG_INFO, "image cache " << fheroes2::AGG::GetImageCacheStatistics().String() );
+    DEBUG_LOG( DBG_ENGINE, DBG_INFO, "sound cache " << GetSoundCacheStatistics().String() );
+
     wav_cache.clear();
     mid_cache.clear();
     loop_sounds.clear();
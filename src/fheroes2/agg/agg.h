@@ -23,10 +23,16 @@
 #ifndef H2AGG_H
 #define H2AGG_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+namespace fheroes2
+{
+    struct CacheStatistics;
+}
+
 namespace AGG
 {
     class AGGInitializer
@@ -46,6 +52,10 @@ namespace AGG
     void PlayMusic( int mus, bool loop = true, bool asyncronizedCall = false );
     void ResetMixer( bool asyncronizedCall = false );
 
+    // Set the maximum amount of memory in bytes used by decoded sounds and music. 0 means no limit.
+    void SetSoundCacheLimit( const size_t bytes );
+    fheroes2::CacheStatistics GetSoundCacheStatistics();
+
     std::vector<uint8_t> ReadChunk( const std::string & key );
 }
 
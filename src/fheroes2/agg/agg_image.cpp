@@ -18,6 +18,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstring>
@@ -27,11 +28,15 @@
 #include "agg.h"
 #include "agg_file.h"
 #include "agg_image.h"
+#include "cache_tracker.h"
 #include "h2d.h"
 #include "icn.h"
 #include "image.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "pal.h"
+#include "parallel.h"
+#include "profiler.h"
 #include "screen.h"
 #include "text.h"
 #include "til.h"
@@ -50,6 +55,153 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    // All images are accounted by a single tracker: ICN IDs are used as keys directly and TIL IDs are placed after them.
+    fheroes2::CacheTracker _imageCacheTracker( ICN::LASTICN + TIL::LASTTIL );
+
+    size_t getImageMemorySize( const fheroes2::Image & image )
+    {
+        // Every image has image and transform layers.
+        return static_cast<size_t>( image.width() ) * static_cast<size_t>( image.height() ) * 2;
+    }
+
+    size_t getICNMemorySize( const int id )
+    {
+        size_t size = 0;
+        for ( const fheroes2::Sprite & sprite : _icnVsSprite[id] ) {
+            size += getImageMemorySize( sprite );
+        }
+
+        const std::map<int, std::vector<fheroes2::Sprite>>::const_iterator scaled = _icnVsScaledSprite.find( id );
+        if ( scaled != _icnVsScaledSprite.end() ) {
+            for ( const fheroes2::Sprite & sprite : scaled->second ) {
+                size += getImageMemorySize( sprite );
+            }
+        }
+
+        return size;
+    }
+
+    size_t getTILMemorySize( const int id )
+    {
+        size_t size = 0;
+        for ( const std::vector<fheroes2::Image> & shape : _tilVsImage[id] ) {
+            for ( const fheroes2::Image & image : shape ) {
+                size += getImageMemorySize( image );
+            }
+        }
+
+        return size;
+    }
+
+    bool isPinnedImage( const size_t key )
+    {
+        // Fonts are modified in place while changing the game language so they cannot be reloaded from AGG files.
+        switch ( key ) {
+        case ICN::FONT:
+        case ICN::SMALFONT:
+        case ICN::YELLOW_FONT:
+        case ICN::YELLOW_SMALLFONT:
+        case ICN::GRAY_FONT:
+        case ICN::GRAY_SMALL_FONT:
+        case ICN::WHITE_LARGE_FONT:
+            return true;
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    // ICN sprites decoded in advance by PrefetchICN() function. They are moved into _icnVsSprite on the first request.
+    std::map<int, std::vector<fheroes2::Sprite>> _icnVsPrefetchedSprite;
+
+    // This function has no access to any global state so it is safe to call it from any thread.
+    std::vector<fheroes2::Sprite> decodeICN( const std::vector<uint8_t> & body )
+    {
+        std::vector<fheroes2::Sprite> sprites;
+
+        if ( body.empty() ) {
+            return sprites;
+        }
+
+        StreamBuf imageStream( body );
+
+        const uint32_t count = imageStream.getLE16();
+        const uint32_t blockSize = imageStream.getLE32();
+        if ( count == 0 || blockSize == 0 ) {
+            return sprites;
+        }
+
+        sprites.resize( count );
+
+        for ( uint32_t i = 0; i < count; ++i ) {
+            imageStream.seek( headerSize + i * 13 );
+
+            fheroes2::ICNHeader header1;
+            imageStream >> header1;
+
+            uint32_t sizeData = 0;
+            if ( i + 1 != count ) {
+                fheroes2::ICNHeader header2;
+                imageStream >> header2;
+                sizeData = header2.offsetData - header1.offsetData;
+            }
+            else {
+                sizeData = blockSize - header1.offsetData;
+            }
+
+            const uint8_t * data = body.data() + headerSize + header1.offsetData;
+
+            sprites[i] = fheroes2::decodeICNSprite( data, sizeData, header1.width, header1.height, static_cast<int16_t>( header1.offsetX ),
+                                                    static_cast<int16_t>( header1.offsetY ) );
+        }
+
+        return sprites;
+    }
+
+    // Decodes all 4 shapes of TIL images. Like decodeICN() this function is thread-safe.
+    void decodeTIL( const std::vector<uint8_t> & data, std::vector<std::vector<fheroes2::Image>> & tilShapes )
+    {
+        tilShapes.resize( 4 ); // 4 possible sides
+
+        if ( data.size() < headerSize ) {
+            return;
+        }
+
+        StreamBuf buffer( data );
+
+        const uint32_t count = buffer.getLE16();
+        const uint32_t width = buffer.getLE16();
+        const uint32_t height = buffer.getLE16();
+        const uint32_t size = width * height;
+        if ( headerSize + count * size != data.size() ) {
+            return;
+        }
+
+        std::vector<fheroes2::Image> & originalTIL = tilShapes[0];
+
+        originalTIL.resize( count );
+        for ( uint32_t i = 0; i < count; ++i ) {
+            fheroes2::Image & tilImage = originalTIL[i];
+            tilImage.resize( width, height );
+            tilImage._disableTransformLayer();
+            memcpy( tilImage.image(), data.data() + headerSize + i * size, size );
+            std::fill( tilImage.transform(), tilImage.transform() + width * height, 0 );
+        }
+
+        for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
+            std::vector<fheroes2::Image> & currentTIL = tilShapes[shapeId];
+            currentTIL.resize( count );
+
+            const bool horizontalFlip = ( shapeId & 2 ) != 0;
+            const bool verticalFlip = ( shapeId & 1 ) != 0;
+
+            for ( uint32_t i = 0; i < count; ++i ) {
+                currentTIL[i] = fheroes2::Flip( originalTIL[i], horizontalFlip, verticalFlip );
+            }
+        }
+    }
+
     bool IsValidICNId( int id )
     {
         return id >= 0 && static_cast<size_t>( id ) < _icnVsSprite.size();
@@ -1304,43 +1456,14 @@ namespace fheroes2
     {
         void LoadOriginalICN( int id )
         {
-            const std::vector<uint8_t> & body = ::AGG::ReadChunk( ICN::GetString( id ) );
-
-            if ( body.empty() ) {
+            std::map<int, std::vector<Sprite>>::iterator prefetched = _icnVsPrefetchedSprite.find( id );
+            if ( prefetched != _icnVsPrefetchedSprite.end() ) {
+                _icnVsSprite[id] = std::move( prefetched->second );
+                _icnVsPrefetchedSprite.erase( prefetched );
                 return;
             }
 
-            StreamBuf imageStream( body );
-
-            const uint32_t count = imageStream.getLE16();
-            const uint32_t blockSize = imageStream.getLE32();
-            if ( count == 0 || blockSize == 0 ) {
-                return;
-            }
-
-            _icnVsSprite[id].resize( count );
-
-            for ( uint32_t i = 0; i < count; ++i ) {
-                imageStream.seek( headerSize + i * 13 );
-
-                ICNHeader header1;
-                imageStream >> header1;
-
-                uint32_t sizeData = 0;
-                if ( i + 1 != count ) {
-                    ICNHeader header2;
-                    imageStream >> header2;
-                    sizeData = header2.offsetData - header1.offsetData;
-                }
-                else {
-                    sizeData = blockSize - header1.offsetData;
-                }
-
-                const uint8_t * data = body.data() + headerSize + header1.offsetData;
-
-                _icnVsSprite[id][i]
-                    = decodeICNSprite( data, sizeData, header1.width, header1.height, static_cast<int16_t>( header1.offsetX ), static_cast<int16_t>( header1.offsetY ) );
-            }
+            _icnVsSprite[id] = decodeICN( ::AGG::ReadChunk( ICN::GetString( id ) ) );
         }
 
         // Helper function for LoadModifiedICN
@@ -2524,55 +2647,33 @@ namespace fheroes2
 
         size_t GetMaximumICNIndex( int id )
         {
-            if ( _icnVsSprite[id].empty() && !LoadModifiedICN( id ) ) {
+            if ( !_icnVsSprite[id].empty() ) {
+                _imageCacheTracker.hit( static_cast<size_t>( id ) );
+                return _icnVsSprite[id].size();
+            }
+
+            if ( !LoadModifiedICN( id ) ) {
                 LoadOriginalICN( id );
             }
 
+            _imageCacheTracker.miss( static_cast<size_t>( id ) );
+            _imageCacheTracker.setSize( static_cast<size_t>( id ), getICNMemorySize( id ) );
+
             return _icnVsSprite[id].size();
         }
 
         size_t GetMaximumTILIndex( int id )
         {
-            if ( _tilVsImage[id].empty() ) {
-                _tilVsImage[id].resize( 4 ); // 4 possible sides
-
-                const std::vector<uint8_t> & data = ::AGG::ReadChunk( tilFileName[id] );
-                if ( data.size() < headerSize ) {
-                    return 0;
-                }
+            const size_t key = static_cast<size_t>( ICN::LASTICN + id );
 
-                StreamBuf buffer( data );
-
-                const uint32_t count = buffer.getLE16();
-                const uint32_t width = buffer.getLE16();
-                const uint32_t height = buffer.getLE16();
-                const uint32_t size = width * height;
-                if ( headerSize + count * size != data.size() ) {
-                    return 0;
-                }
-
-                std::vector<Image> & originalTIL = _tilVsImage[id][0];
-
-                originalTIL.resize( count );
-                for ( uint32_t i = 0; i < count; ++i ) {
-                    Image & tilImage = originalTIL[i];
-                    tilImage.resize( width, height );
-                    tilImage._disableTransformLayer();
-                    memcpy( tilImage.image(), data.data() + headerSize + i * size, size );
-                    std::fill( tilImage.transform(), tilImage.transform() + width * height, 0 );
-                }
-
-                for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
-                    std::vector<Image> & currentTIL = _tilVsImage[id][shapeId];
-                    currentTIL.resize( count );
-
-                    const bool horizontalFlip = ( shapeId & 2 ) != 0;
-                    const bool verticalFlip = ( shapeId & 1 ) != 0;
+            if ( _tilVsImage[id].empty() ) {
+                decodeTIL( ::AGG::ReadChunk( tilFileName[id] ), _tilVsImage[id] );
 
-                    for ( uint32_t i = 0; i < count; ++i ) {
-                        currentTIL[i] = Flip( originalTIL[i], horizontalFlip, verticalFlip );
-                    }
-                }
+                _imageCacheTracker.miss( key );
+                _imageCacheTracker.setSize( key, getTILMemorySize( id ) );
+            }
+            else {
+                _imageCacheTracker.hit( key );
             }
 
             return _tilVsImage[id][0].size();
@@ -2615,6 +2716,8 @@ namespace fheroes2
 
         const Sprite & GetICN( int icnId, uint32_t index )
         {
+            PROFILE_ZONE( "AGG::GetICN" );
+
             if ( !IsValidICNId( icnId ) ) {
                 return errorImage;
             }
@@ -2657,6 +2760,122 @@ namespace fheroes2
             return _tilVsImage[tilId][shapeId][index];
         }
 
+        void PrefetchICN( const std::vector<int> & icnIds )
+        {
+            std::vector<int> decodeIds;
+            std::vector<std::vector<uint8_t>> bodies;
+
+            // AGG files are not thread-safe so all data must be read by the calling thread.
+            for ( const int id : icnIds ) {
+                if ( !IsValidICNId( id ) || !_icnVsSprite[id].empty() || _icnVsPrefetchedSprite.count( id ) > 0 ) {
+                    continue;
+                }
+
+                if ( std::find( decodeIds.begin(), decodeIds.end(), id ) != decodeIds.end() ) {
+                    continue;
+                }
+
+                std::vector<uint8_t> body = ::AGG::ReadChunk( ICN::GetString( id ) );
+                if ( body.empty() ) {
+                    continue;
+                }
+
+                decodeIds.push_back( id );
+                bodies.emplace_back( std::move( body ) );
+            }
+
+            std::vector<std::vector<Sprite>> decoded( decodeIds.size() );
+
+            parallelFor( decodeIds.size(), [&bodies, &decoded]( const size_t taskId ) { decoded[taskId] = decodeICN( bodies[taskId] ); } );
+
+            for ( size_t i = 0; i < decodeIds.size(); ++i ) {
+                _icnVsPrefetchedSprite.emplace( decodeIds[i], std::move( decoded[i] ) );
+            }
+
+            // Modified ICNs are generated by the calling thread as they could depend on other ICNs.
+            for ( const int id : icnIds ) {
+                if ( IsValidICNId( id ) ) {
+                    GetMaximumICNIndex( id );
+                    _icnVsPrefetchedSprite.erase( id );
+                }
+            }
+        }
+
+        void PrefetchTIL( const std::vector<int> & tilIds )
+        {
+            std::vector<int> decodeIds;
+            std::vector<std::vector<uint8_t>> bodies;
+
+            for ( const int id : tilIds ) {
+                if ( !IsValidTILId( id ) || !_tilVsImage[id].empty() || std::find( decodeIds.begin(), decodeIds.end(), id ) != decodeIds.end() ) {
+                    continue;
+                }
+
+                decodeIds.push_back( id );
+                bodies.emplace_back( ::AGG::ReadChunk( tilFileName[id] ) );
+            }
+
+            std::vector<std::vector<std::vector<Image>>> decoded( decodeIds.size() );
+
+            parallelFor( decodeIds.size(), [&bodies, &decoded]( const size_t taskId ) { decodeTIL( bodies[taskId], decoded[taskId] ); } );
+
+            for ( size_t i = 0; i < decodeIds.size(); ++i ) {
+                _tilVsImage[decodeIds[i]] = std::move( decoded[i] );
+            }
+        }
+
+        void WarmUpCache()
+        {
+            PrefetchTIL( { TIL::GROUND32, TIL::CLOF32, TIL::STON } );
+
+            PrefetchICN( { ICN::FONT, ICN::SMALFONT, ICN::ADVBORD, ICN::ADVBTNS, ICN::ADVMCO, ICN::REDBACK, ICN::ROUTE, ICN::BOAT32, ICN::MINIMON, ICN::MINIHERO,
+                           ICN::MINIPORT, ICN::MINICAPT, ICN::MONS32, ICN::OBJNGRAS, ICN::OBJNGRA2, ICN::OBJNDIRT, ICN::OBJNMULT, ICN::OBJNMUL2, ICN::OBJNRSRC,
+                           ICN::OBJNARTI, ICN::MTNGRAS, ICN::TREJNGL, ICN::TREDECI, ICN::TREFIR, ICN::TEXTBAR, ICN::CMSECO, ICN::SPELLS, ICN::EXPMRL } );
+        }
+
+        void SetImageCacheLimit( const size_t bytes )
+        {
+            _imageCacheTracker.setLimit( bytes );
+        }
+
+        void ReleaseUnusedImages()
+        {
+            // Some images are modified outside of their loading functions so sizes are refreshed before making any decision.
+            for ( size_t id = 0; id < _icnVsSprite.size(); ++id ) {
+                _imageCacheTracker.setSize( id, getICNMemorySize( static_cast<int>( id ) ) );
+            }
+
+            for ( size_t id = 0; id < _tilVsImage.size(); ++id ) {
+                _imageCacheTracker.setSize( ICN::LASTICN + id, getTILMemorySize( static_cast<int>( id ) ) );
+            }
+
+            const std::vector<size_t> evictionList = _imageCacheTracker.getEvictionList( isPinnedImage );
+            if ( evictionList.empty() ) {
+                DEBUG_LOG( DBG_ENGINE, DBG_TRACE, "image cache " << _imageCacheTracker.statistics().String() );
+                return;
+            }
+
+            for ( const size_t key : evictionList ) {
+                if ( key < ICN::LASTICN ) {
+                    _icnVsSprite[key].clear();
+                    _icnVsSprite[key].shrink_to_fit();
+                    _icnVsScaledSprite.erase( static_cast<int>( key ) );
+                }
+                else {
+                    _tilVsImage[key - ICN::LASTICN].clear();
+                }
+
+                _imageCacheTracker.release( key );
+            }
+
+            DEBUG_LOG( DBG_ENGINE, DBG_INFO, "released " << evictionList.size() << " image sets, image cache " << _imageCacheTracker.statistics().String() );
+        }
+
+        const CacheStatistics & GetImageCacheStatistics()
+        {
+            return _imageCacheTracker.statistics();
+        }
+
         const Sprite & GetLetter( uint32_t character, uint32_t fontType )
         {
             if ( character < 0x21 ) {
@@ -20,10 +20,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 namespace fheroes2
 {
+    struct CacheStatistics;
     class Image;
     class Sprite;
     enum class FontSize : uint8_t;
@@ -37,6 +40,23 @@ namespace fheroes2
 
         // shapeId could be 0, 1, 2 or 3 only
         const Image & GetTIL( int tilId, uint32_t index, uint32_t shapeId );
+        // Decode the given resources in advance using all available CPU cores so their first use does not cause a delay.
+        // These functions must be called from the main thread only. Already loaded resources are skipped.
+        void PrefetchICN( const std::vector<int> & icnIds );
+        void PrefetchTIL( const std::vector<int> & tilIds );
+
+        // Prefetch the most commonly used resources: fonts, terrain, adventure map objects and interface elements.
+        void WarmUpCache();
+
+        // Set the maximum amount of memory in bytes used by decoded images. 0 means no limit.
+        void SetImageCacheLimit( const size_t bytes );
+
+        // Release the least recently used images to fit the limit. Fonts are never released.
+        // IMPORTANT: call this function only when no references to images are held, for example, between game screens.
+        void ReleaseUnusedImages();
+
+        const CacheStatistics & GetImageCacheStatistics();
+
         const Sprite & GetLetter( uint32_t character, uint32_t fontType );
 
         // Returns the last supported ASCII character in existing font.
@@ -63,14 +63,17 @@ namespace AI
     const double ARMY_STRENGTH_ADVANTAGE_MEDUIM = 1.5;
     const double ARMY_STRENGTH_ADVANTAGE_LARGE = 1.8;
 
+    // Number of days of movement within which the AI heroes evaluate objects using exact paths
+    const uint32_t HERO_SEARCH_DAY_LIMIT = 3;
+
     class Base
     {
     public:
         virtual void KingdomTurn( Kingdom & kingdom );
-        virtual void CastleTurn( Castle & castle, bool defensive );
+        virtual void CastleTurn( Castle & castle, bool defensive, const Rand::DeterministicRandomGenerator & randomGenerator );
         virtual void BattleTurn( Battle::Arena & arena, const Battle::Unit & unit, Battle::Actions & actions );
         virtual void HeroTurn( Heroes & hero );
-        virtual bool HeroesTurn( VecHeroes & )
+        virtual bool HeroesTurn( VecHeroes &, const Rand::DeterministicRandomGenerator & )
         {
             return true;
         }
@@ -104,12 +107,31 @@ namespace AI
 
         virtual ~Base() = default;
 
+        // Hero actions are started by the hero movement code. They use the random generator handed to the kingdom turn in progress.
+        const Rand::DeterministicRandomGenerator & getHeroActionRandomGenerator() const;
+
     protected:
+        // Makes the given generator the generator of the hero actions until the end of the kingdom turn.
+        class HeroActionRandomScope
+        {
+        public:
+            HeroActionRandomScope( Base & ai, const Rand::DeterministicRandomGenerator & randomGenerator );
+            HeroActionRandomScope( const HeroActionRandomScope & ) = delete;
+            HeroActionRandomScope & operator=( const HeroActionRandomScope & ) = delete;
+
+            ~HeroActionRandomScope();
+
+        private:
+            Base & _ai;
+        };
+
         int _personality = NONE;
 
         Base() = default;
 
     private:
+        const Rand::DeterministicRandomGenerator * _heroActionRandomGenerator = nullptr;
+
         friend StreamBase & operator<<( StreamBase &, const AI::Base & );
         friend StreamBase & operator>>( StreamBase &, AI::Base & );
     };
@@ -117,16 +139,28 @@ namespace AI
     Base & Get( AI_TYPE type = AI_TYPE::NORMAL );
 
     // functionality in ai_hero_action.cpp
-    void HeroesAction( Heroes & hero, s32 dst_index, bool isDestination );
+    void HeroesAction( Heroes & hero, s32 dst_index, bool isDestination, const Rand::DeterministicRandomGenerator & randomGenerator );
     void HeroesMove( Heroes & hero );
 
     // functionality in ai_common.cpp
-    bool BuildIfAvailable( Castle & castle, int building );
-    bool BuildIfEnoughResources( Castle & castle, int building, uint32_t minimumMultiplicator );
-    uint32_t GetResourceMultiplier( const Castle & castle, uint32_t min, uint32_t max );
+    bool BuildIfAvailable( Castle & castle, int building, const Rand::DeterministicRandomGenerator & randomGenerator );
+    bool BuildIfEnoughResources( Castle & castle, int building, uint32_t minimumMultiplicator, const Rand::DeterministicRandomGenerator & randomGenerator );
+    uint32_t GetResourceMultiplier( const Castle & castle, uint32_t min, uint32_t max, const Rand::DeterministicRandomGenerator & randomGenerator );
     void ReinforceHeroInCastle( Heroes & hero, Castle & castle, const Funds & budget );
     void OptimizeTroopsOrder( Army & hero );
 
+    // functionality in ai_action_log.cpp
+    enum class ActionType : int
+    {
+        HERO_TARGET,
+        HERO_ACTION,
+        BUILD,
+        RECRUIT_HERO
+    };
+
+    // Writes the decision to the action log of the game session, see ActionLog.
+    void logAction( const ActionType type, const int color, const int32_t subject, const int32_t target, const size_t seed );
+
     StreamBase & operator<<( StreamBase &, const AI::Base & );
     StreamBase & operator>>( StreamBase &, AI::Base & );
 }
@@ -0,0 +1,157 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <sstream>
+
+#include "ai.h"
+#include "ai_action_log.h"
+#include "game_session.h"
+#include "logging.h"
+#include "world.h"
+
+namespace
+{
+    const char * actionTypeString( const AI::ActionType type )
+    {
+        switch ( type ) {
+        case AI::ActionType::HERO_TARGET:
+            return "target";
+        case AI::ActionType::HERO_ACTION:
+            return "action";
+        case AI::ActionType::BUILD:
+            return "build";
+        case AI::ActionType::RECRUIT_HERO:
+            return "recruit";
+        default:
+            break;
+        }
+
+        return "unknown";
+    }
+}
+
+namespace AI
+{
+    ActionLog::~ActionLog()
+    {
+        close();
+    }
+
+    bool ActionLog::open( const std::string & fileName, const bool replay, const uint32_t mapSeed, const uint32_t day )
+    {
+        close();
+
+        if ( replay ) {
+            std::ifstream input( fileName );
+            if ( !input ) {
+                ERROR_LOG( "Unable to open AI action log " << fileName )
+                return false;
+            }
+
+            std::string line;
+            while ( std::getline( input, line ) ) {
+                if ( !line.empty() ) {
+                    _expected.emplace_back( std::move( line ) );
+                }
+            }
+
+            _mode = Mode::REPLAY;
+        }
+        else {
+            _output.open( fileName, std::ios::out | std::ios::trunc );
+            if ( !_output ) {
+                ERROR_LOG( "Unable to create AI action log " << fileName )
+                return false;
+            }
+
+            _mode = Mode::RECORD;
+        }
+
+        std::ostringstream os;
+        os << "game " << mapSeed << ' ' << day;
+
+        processRecord( os.str() );
+
+        return true;
+    }
+
+    void ActionLog::close()
+    {
+        if ( _mode == Mode::REPLAY && !_diverged ) {
+            if ( _position < _expected.size() ) {
+                ERROR_LOG( "AI replay stopped at record " << _position << " of " << _expected.size() )
+            }
+            else {
+                DEBUG_LOG( DBG_AI, DBG_INFO, "AI replay matched all " << _expected.size() << " records" )
+            }
+        }
+
+        _mode = Mode::NONE;
+        _output.close();
+        _expected.clear();
+        _position = 0;
+        _diverged = false;
+    }
+
+    void ActionLog::log( const ActionType type, const uint32_t day, const int color, const int32_t subject, const int32_t target, const size_t seed )
+    {
+        if ( _mode == Mode::NONE ) {
+            return;
+        }
+
+        // Generators use only the lower 32 bits of their seeds.
+        std::ostringstream os;
+        os << day << ' ' << color << ' ' << actionTypeString( type ) << ' ' << subject << ' ' << target << ' ' << static_cast<uint32_t>( seed );
+
+        processRecord( os.str() );
+    }
+
+    void ActionLog::processRecord( const std::string & record )
+    {
+        if ( _mode == Mode::RECORD ) {
+            _output << record << std::endl;
+            return;
+        }
+
+        if ( _diverged ) {
+            return;
+        }
+
+        if ( _position >= _expected.size() ) {
+            ERROR_LOG( "AI replay diverged at record " << _position << ": the log has no more records, got '" << record << "'" )
+            _diverged = true;
+            return;
+        }
+
+        const std::string & expected = _expected[_position];
+        if ( expected != record ) {
+            ERROR_LOG( "AI replay diverged at record " << _position << ": expected '" << expected << "', got '" << record << "'" )
+            _diverged = true;
+            return;
+        }
+
+        ++_position;
+    }
+
+    void logAction( const ActionType type, const int color, const int32_t subject, const int32_t target, const size_t seed )
+    {
+        Game::Session::Get().getActionLog().log( type, world.CountDay(), color, subject, target, seed );
+    }
+}
@@ -0,0 +1,81 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef H2AI_ACTION_LOG_H
+#define H2AI_ACTION_LOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace AI
+{
+    enum class ActionType : int;
+
+    // Every AI decision of a game is written to the log file as a line of text together with the day, the kingdom color and the seed of the random
+    // stream used by the decision. In replay mode the decisions are compared with a previously recorded log instead and the first divergence is reported.
+    // Each game session owns its own log.
+    class ActionLog
+    {
+    public:
+        ActionLog() = default;
+        ActionLog( const ActionLog & ) = delete;
+        ActionLog & operator=( const ActionLog & ) = delete;
+
+        ~ActionLog();
+
+        // Opens the log file for the game which starts on the given day. Returns false if the file cannot be opened.
+        bool open( const std::string & fileName, const bool replay, const uint32_t mapSeed, const uint32_t day );
+
+        // Reports the result of the replay and closes the log file.
+        void close();
+
+        bool isOpen() const
+        {
+            return _mode != Mode::NONE;
+        }
+
+        bool isDiverged() const
+        {
+            return _diverged;
+        }
+
+        void log( const ActionType type, const uint32_t day, const int color, const int32_t subject, const int32_t target, const size_t seed );
+
+    private:
+        enum class Mode : int
+        {
+            NONE,
+            RECORD,
+            REPLAY
+        };
+
+        void processRecord( const std::string & record );
+
+        Mode _mode = Mode::NONE;
+        std::ofstream _output;
+        std::vector<std::string> _expected;
+        size_t _position = 0;
+        bool _diverged = false;
+    };
+}
+
+#endif
@@ -18,6 +18,8 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <cassert>
+
 #include "agg.h"
 #include "ai.h"
 #include "battle_arena.h"
@@ -30,6 +32,7 @@
 #include "mus.h"
 #include "serialize.h"
 #include "translations.h"
+#include "world.h"
 
 namespace AI
 {
@@ -74,7 +77,7 @@ namespace AI
         // Do nothing.
     }
 
-    void Base::CastleTurn( Castle &, bool )
+    void Base::CastleTurn( Castle &, bool, const Rand::DeterministicRandomGenerator & )
     {
         // Do nothing.
     }
@@ -151,6 +154,25 @@ namespace AI
         return false;
     }
 
+    const Rand::DeterministicRandomGenerator & Base::getHeroActionRandomGenerator() const
+    {
+        // Hero actions of AI kingdoms can only happen during their turns.
+        assert( _heroActionRandomGenerator != nullptr );
+        return *_heroActionRandomGenerator;
+    }
+
+    Base::HeroActionRandomScope::HeroActionRandomScope( Base & ai, const Rand::DeterministicRandomGenerator & randomGenerator )
+        : _ai( ai )
+    {
+        assert( _ai._heroActionRandomGenerator == nullptr );
+        _ai._heroActionRandomGenerator = &randomGenerator;
+    }
+
+    Base::HeroActionRandomScope::~HeroActionRandomScope()
+    {
+        _ai._heroActionRandomGenerator = nullptr;
+    }
+
     bool Base::HeroesCanMove( const Heroes & hero )
     {
         return hero.MayStillMove( false, false ) && !hero.Modes( Heroes::MOVED );
@@ -200,6 +222,9 @@ namespace AI
 
         AGG::PlayMusic( MUS::COMPUTER_TURN, true, true );
 
+        const Rand::DeterministicRandomGenerator & castleRandomGenerator = world.getRandomGenerator( World::RandomStream::AI_CASTLE );
+        const HeroActionRandomScope heroActionRandomScope( *this, world.getRandomGenerator( World::RandomStream::AI_HERO_ACTION ) );
+
         Interface::StatusWindow & status = Interface::Basic::Get().GetStatusWindow();
 
         // indicator
@@ -210,7 +235,7 @@ namespace AI
         // castles AI turn
         for ( KingdomCastles::iterator it = castles.begin(); it != castles.end(); ++it )
             if ( *it )
-                CastleTurn( **it, false );
+                CastleTurn( **it, false, castleRandomGenerator );
 
         status.RedrawTurnProgress( 3 );
 
@@ -0,0 +1,206 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstdint>
+#include <random>
+
+#include "ai_battle_estimator.h"
+#include "army.h"
+#include "army_troop.h"
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "heroes.h"
+#include "logging.h"
+#include "rand.h"
+
+namespace
+{
+    // Every battle is played this many times
+    const uint32_t rolloutCount = 8;
+
+    // Battles longer than this are considered to be a draw
+    const uint32_t maxRolloutTurns = 50;
+
+    uint64_t mixHash( uint64_t hash, const uint64_t value )
+    {
+        // FNV-1a over 64-bit values
+        hash ^= value;
+        return hash * 0x100000001B3ULL;
+    }
+
+    // The key includes everything which affects the battle and may change during a turn
+    uint64_t getArmyHash( uint64_t hash, const Army & army )
+    {
+        for ( size_t i = 0; i < army.Size(); ++i ) {
+            const Troop * troop = army.GetTroop( i );
+            if ( troop != nullptr && troop->isValid() ) {
+                hash = mixHash( hash, static_cast<uint64_t>( troop->GetID() ) | ( static_cast<uint64_t>( troop->GetCount() ) << 32 ) );
+            }
+            else {
+                hash = mixHash( hash, 0 );
+            }
+        }
+
+        hash = mixHash( hash, static_cast<uint64_t>( army.GetColor() ) | ( static_cast<uint64_t>( army.isSpreadFormat() ) << 32 ) );
+
+        const HeroBase * commander = army.GetCommander();
+        if ( commander != nullptr ) {
+            hash = mixHash( hash, reinterpret_cast<uintptr_t>( commander ) );
+            hash = mixHash( hash, static_cast<uint64_t>( commander->GetAttack() ) | ( static_cast<uint64_t>( commander->GetDefense() ) << 32 ) );
+            hash = mixHash( hash, static_cast<uint64_t>( commander->GetPower() ) | ( static_cast<uint64_t>( commander->GetKnowledge() ) << 32 ) );
+            hash = mixHash( hash, commander->GetSpellPoints() );
+        }
+
+        return hash;
+    }
+
+    double getForceStrength( const Battle::Force & force )
+    {
+        double strength = 0;
+
+        for ( const Battle::Unit * unit : force ) {
+            if ( unit != nullptr && unit->isValid() ) {
+                strength += unit->GetStrength();
+            }
+        }
+
+        return strength;
+    }
+
+    struct RolloutResult
+    {
+        bool isWin = false;
+        double attackerLosses = 0;
+        double defenderLosses = 0;
+    };
+
+    RolloutResult playRollout( Army & attacker, Army & defender, const int32_t tileIndex, const uint32_t seed )
+    {
+        // Some battle actions and unit animations use the random generator of the thread
+        Rand::CurrentThreadRandomDevice().seed( seed );
+
+        Rand::DeterministicRandomGenerator randomGenerator( seed );
+        Battle::Arena arena( attacker, defender, tileIndex, false, randomGenerator );
+
+        const double attackerStrength = getForceStrength( arena.GetForce1() );
+        const double defenderStrength = getForceStrength( arena.GetForce2() );
+
+        for ( uint32_t turn = 0; turn < maxRolloutTurns && arena.BattleValid(); ++turn ) {
+            arena.Turns();
+        }
+
+        RolloutResult result;
+        result.isWin = ( arena.GetResult().army1 & Battle::RESULT_WINS ) != 0;
+        result.attackerLosses = attackerStrength > 0 ? 1.0 - getForceStrength( arena.GetForce1() ) / attackerStrength : 0;
+        result.defenderLosses = defenderStrength > 0 ? 1.0 - getForceStrength( arena.GetForce2() ) / defenderStrength : 0;
+
+        return result;
+    }
+
+    // Battles use spell points of the commanders and mark them as having cast a spell this round
+    class CommanderState
+    {
+    public:
+        explicit CommanderState( HeroBase * commander )
+            : _commander( commander )
+            , _spellPoints( commander ? commander->GetSpellPoints() : 0 )
+            , _isSpellCasted( commander && commander->Modes( Heroes::SPELLCASTED ) )
+        {}
+
+        CommanderState( const CommanderState & ) = delete;
+        CommanderState & operator=( const CommanderState & ) = delete;
+
+        void restore() const
+        {
+            if ( _commander == nullptr ) {
+                return;
+            }
+
+            _commander->SetSpellPoints( _spellPoints );
+
+            if ( _isSpellCasted ) {
+                _commander->SetModes( Heroes::SPELLCASTED );
+            }
+            else {
+                _commander->ResetModes( Heroes::SPELLCASTED );
+            }
+        }
+
+    private:
+        HeroBase * _commander;
+        const uint32_t _spellPoints;
+        const bool _isSpellCasted;
+    };
+}
+
+namespace AI
+{
+    BattleEstimate BattleEstimator::estimate( Army & attacker, Army & defender, const int32_t tileIndex )
+    {
+        BattleEstimate estimate;
+
+        if ( !attacker.isValid() || !defender.isValid() ) {
+            estimate.winProbability = defender.isValid() ? 0 : 1;
+            return estimate;
+        }
+
+        const uint64_t key = mixHash( getArmyHash( getArmyHash( 0xCBF29CE484222325ULL, attacker ), defender ), static_cast<uint64_t>( tileIndex ) );
+
+        const auto it = _cache.find( key );
+        if ( it != _cache.end() ) {
+            return it->second;
+        }
+
+        // Rollouts are played one by one on the calling thread: the arena is bound to the thread and battles modify the commanders
+        // which are restored after every battle.
+        const CommanderState attackerCommander( attacker.GetCommander() );
+        const CommanderState defenderCommander( defender.GetCommander() );
+
+        // The estimate must not affect the random values drawn by the game
+        const std::mt19937 threadGenerator = Rand::CurrentThreadRandomDevice();
+
+        uint32_t wins = 0;
+        for ( uint32_t i = 0; i < rolloutCount; ++i ) {
+            const RolloutResult result = playRollout( attacker, defender, tileIndex, static_cast<uint32_t>( mixHash( key, i ) ) );
+
+            attackerCommander.restore();
+            defenderCommander.restore();
+
+            wins += result.isWin ? 1 : 0;
+            estimate.attackerLosses += result.attackerLosses;
+            estimate.defenderLosses += result.defenderLosses;
+        }
+
+        Rand::CurrentThreadRandomDevice() = threadGenerator;
+
+        estimate.winProbability = static_cast<double>( wins ) / rolloutCount;
+        estimate.attackerLosses /= rolloutCount;
+        estimate.defenderLosses /= rolloutCount;
+
+        DEBUG_LOG( DBG_AI, DBG_TRACE,
+                   "win probability: " << estimate.winProbability << ", attacker losses: " << estimate.attackerLosses << ", defender losses: " << estimate.defenderLosses )
+
+        _cache.emplace( key, estimate );
+
+        return estimate;
+    }
+}
@@ -0,0 +1,58 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef H2AI_BATTLE_ESTIMATOR_H
+#define H2AI_BATTLE_ESTIMATOR_H
+
+#include <cstdint>
+#include <unordered_map>
+
+class Army;
+
+namespace AI
+{
+    struct BattleEstimate
+    {
+        double winProbability = 0;
+        // Average share of the army strength lost in the battle, from 0 to 1
+        double attackerLosses = 0;
+        double defenderLosses = 0;
+    };
+
+    // Estimates the outcome of a battle by playing it several times on a headless battle arena at the tile of the map where it takes place,
+    // so castles, obstacles, hero spells and the battle AI are taken into account. The armies and their commanders are left unchanged.
+    class BattleEstimator
+    {
+    public:
+        // Must not be called during a battle.
+        BattleEstimate estimate( Army & attacker, Army & defender, const int32_t tileIndex );
+
+        // Results are cached by the armies, their commanders and the tile until the cache is cleared.
+        void clear()
+        {
+            _cache.clear();
+        }
+
+    private:
+        std::unordered_map<uint64_t, BattleEstimate> _cache;
+    };
+}
+
+#endif
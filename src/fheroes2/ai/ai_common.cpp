@@ -22,6 +22,7 @@
 #include "army.h"
 #include "army_troop.h"
 #include "castle.h"
+#include "game_session.h"
 #include "kingdom.h"
 #include "normal/ai_normal.h"
 
@@ -30,31 +31,32 @@ namespace AI
     // AI Selector here
     Base & Get( AI_TYPE /*type*/ ) // type might be used sometime in the future
     {
-        static AI::Normal normal;
-        return normal;
+        return Game::Session::Get().getAI();
     }
 
-    bool BuildIfAvailable( Castle & castle, int building )
+    bool BuildIfAvailable( Castle & castle, int building, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
-        if ( !castle.isBuild( building ) )
-            return castle.BuyBuilding( building );
-        return false;
+        if ( castle.isBuild( building ) || !castle.BuyBuilding( building ) )
+            return false;
+
+        logAction( ActionType::BUILD, castle.GetColor(), castle.GetIndex(), building, randomGenerator.GetSeed() );
+        return true;
     }
 
-    bool BuildIfEnoughResources( Castle & castle, int building, uint32_t minimumMultiplicator )
+    bool BuildIfEnoughResources( Castle & castle, int building, uint32_t minimumMultiplicator, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         if ( minimumMultiplicator < 1 || minimumMultiplicator > 99 ) // can't be that we need more than 100 times resources
             return false;
 
         const Kingdom & kingdom = castle.GetKingdom();
         if ( kingdom.GetFunds() >= PaymentConditions::BuyBuilding( castle.GetRace(), building ) * minimumMultiplicator )
-            return BuildIfAvailable( castle, building );
+            return BuildIfAvailable( castle, building, randomGenerator );
         return false;
     }
 
-    uint32_t GetResourceMultiplier( const Castle & castle, uint32_t min, uint32_t max )
+    uint32_t GetResourceMultiplier( const Castle & castle, uint32_t min, uint32_t max, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
-        return castle.isCapital() ? 1 : Rand::Get( min, max );
+        return castle.isCapital() ? 1 : randomGenerator.Get( min, max );
     }
 
     void ReinforceHeroInCastle( Heroes & hero, Castle & castle, const Funds & budget )
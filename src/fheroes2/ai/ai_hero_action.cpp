@@ -96,7 +96,7 @@ namespace AI
 {
     void AIToMonster( Heroes & hero, s32 dst_index );
     void AIToPickupResource( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index );
-    void AIToTreasureChest( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index );
+    void AIToTreasureChest( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index, const Rand::DeterministicRandomGenerator & randomGenerator );
     void AIToArtifact( Heroes & hero, s32 dst_index );
     void AIToObjectResource( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index );
     void AIToWagon( Heroes & hero, s32 dst_index );
@@ -105,9 +105,9 @@ namespace AI
     void AIToFlotSam( const Heroes & hero, s32 dst_index );
     void AIToObservationTower( Heroes & hero, s32 dst_index );
     void AIToMagellanMaps( Heroes & hero, s32 dst_index );
-    void AIToTeleports( Heroes & hero, s32 dst_index );
-    void AIToWhirlpools( Heroes & hero, s32 dst_index );
-    void AIToPrimarySkillObject( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index );
+    void AIToTeleports( Heroes & hero, s32 dst_index, const Rand::DeterministicRandomGenerator & randomGenerator );
+    void AIToWhirlpools( Heroes & hero, s32 dst_index, const Rand::DeterministicRandomGenerator & randomGenerator );
+    void AIToPrimarySkillObject( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index, const Rand::DeterministicRandomGenerator & randomGenerator );
     void AIToExperienceObject( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index );
     void AIToWitchsHut( Heroes & hero, s32 dst_index );
     void AIToShrine( Heroes & hero, s32 dst_index );
@@ -137,12 +137,12 @@ namespace AI
     void AIToBoat( Heroes & hero, s32 dst_index );
     void AIToCoast( Heroes & hero, s32 dst_index );
     void AIMeeting( Heroes & hero1, Heroes & hero2 );
-    void AIWhirlpoolTroopLooseEffect( Heroes & hero );
+    void AIWhirlpoolTroopLooseEffect( Heroes & hero, const Rand::DeterministicRandomGenerator & randomGenerator );
     void AIToJail( const Heroes & hero, const int32_t tileIndex );
     void AIToHutMagi( Heroes & hero, const MP2::MapObjectType objectType, const int32_t tileIndex );
     void AIToAlchemistTower( Heroes & hero );
 
-    int AISelectPrimarySkill( const Heroes & hero )
+    int AISelectPrimarySkill( const Heroes & hero, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         switch ( hero.GetRace() ) {
         case Race::KNGT: {
@@ -199,7 +199,7 @@ namespace AI
             break;
         }
 
-        switch ( Rand::Get( 1, 4 ) ) {
+        switch ( randomGenerator.Get( 1, 4 ) ) {
         case 1:
             return Skill::Primary::ATTACK;
         case 2:
@@ -234,7 +234,7 @@ namespace AI
         hero.SetFreeman( reason );
     }
 
-    void HeroesAction( Heroes & hero, s32 dst_index, bool isDestination )
+    void HeroesAction( Heroes & hero, s32 dst_index, bool isDestination, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         const Maps::Tiles & tile = world.GetTiles( dst_index );
         const MP2::MapObjectType objectType = tile.GetObject( dst_index != hero.GetIndex() );
@@ -244,6 +244,8 @@ namespace AI
         if ( isActionObject )
             hero.SetModes( Heroes::ACTION );
 
+        logAction( ActionType::HERO_ACTION, hero.GetColor(), hero.GetID(), dst_index, randomGenerator.GetSeed() );
+
         switch ( objectType ) {
         case MP2::OBJ_BOAT:
             AIToBoat( hero, dst_index );
@@ -271,7 +273,7 @@ namespace AI
 
         case MP2::OBJ_WATERCHEST:
         case MP2::OBJ_TREASURECHEST:
-            AIToTreasureChest( hero, objectType, dst_index );
+            AIToTreasureChest( hero, objectType, dst_index, randomGenerator );
             break;
         case MP2::OBJ_ARTIFACT:
             AIToArtifact( hero, dst_index );
@@ -327,11 +329,11 @@ namespace AI
 
             // teleports
         case MP2::OBJ_STONELITHS:
-            AIToTeleports( hero, dst_index );
+            AIToTeleports( hero, dst_index, randomGenerator );
             break;
         case MP2::OBJ_WHIRLPOOL:
             if ( isDestination )
-                AIToWhirlpools( hero, dst_index );
+                AIToWhirlpools( hero, dst_index, randomGenerator );
             break;
 
         // primary skill modification
@@ -339,7 +341,7 @@ namespace AI
         case MP2::OBJ_MERCENARYCAMP:
         case MP2::OBJ_DOCTORHUT:
         case MP2::OBJ_STANDINGSTONES:
-            AIToPrimarySkillObject( hero, objectType, dst_index );
+            AIToPrimarySkillObject( hero, objectType, dst_index, randomGenerator );
             break;
 
             // experience modification
@@ -458,7 +460,7 @@ namespace AI
             AIToStables( hero, objectType, dst_index );
             break;
         case MP2::OBJ_ARENA:
-            AIToPrimarySkillObject( hero, objectType, dst_index );
+            AIToPrimarySkillObject( hero, objectType, dst_index, randomGenerator );
             break;
 
         case MP2::OBJ_BARRIER:
@@ -710,7 +712,7 @@ namespace AI
         DEBUG_LOG( DBG_AI, DBG_INFO, hero.GetName() << " pickup small resource" );
     }
 
-    void AIToTreasureChest( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index )
+    void AIToTreasureChest( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         Maps::Tiles & tile = world.GetTiles( dst_index );
         u32 gold = tile.QuantityGold();
@@ -731,12 +733,12 @@ namespace AI
 
                 if ( hero.getAIRole() == Heroes::Role::HUNTER ) {
                     // Only 10% chance of choosing experience. Make AI rich!
-                    if ( Rand::Get( 1, 10 ) == 1 ) {
+                    if ( randomGenerator.Get( 1, 10 ) == 1 ) {
                         gold = 0;
                         hero.IncreaseExperience( expr );
                     }
                 }
-                else if ( Rand::Get( 1, 2 ) == 1 ) {
+                else if ( randomGenerator.Get( 1, 2 ) == 1 ) {
                     // 50/50 chance.
                     gold = 0;
                     hero.IncreaseExperience( expr );
@@ -892,7 +894,7 @@ namespace AI
         DEBUG_LOG( DBG_AI, DBG_INFO, hero.GetName() );
     }
 
-    void AIToTeleports( Heroes & hero, const int32_t startIndex )
+    void AIToTeleports( Heroes & hero, const int32_t startIndex, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         MapsIndexes teleports = world.GetTeleportEndPoints( startIndex );
 
@@ -921,7 +923,7 @@ namespace AI
             return;
         }
 
-        const int32_t indexTo = Rand::Get( teleports );
+        const int32_t indexTo = randomGenerator.Get( teleports );
         if ( startIndex == indexTo ) {
             DEBUG_LOG( DBG_AI, DBG_WARN, "AI hero " << hero.GetName() << " has teleportation tile the same as starting position: " << startIndex );
             return;
@@ -963,7 +965,7 @@ namespace AI
         DEBUG_LOG( DBG_AI, DBG_INFO, hero.GetName() );
     }
 
-    void AIToWhirlpools( Heroes & hero, s32 index_from )
+    void AIToWhirlpools( Heroes & hero, s32 index_from, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         const int32_t index_to = world.NextWhirlpool( index_from );
 
@@ -977,7 +979,7 @@ namespace AI
         }
         hero.Move2Dest( index_to );
 
-        AIWhirlpoolTroopLooseEffect( hero );
+        AIWhirlpoolTroopLooseEffect( hero, randomGenerator );
 
         hero.GetPath().Reset();
         if ( AIHeroesShowAnimation( hero, AIGetAllianceColors() ) ) {
@@ -989,7 +991,7 @@ namespace AI
         DEBUG_LOG( DBG_AI, DBG_INFO, hero.GetName() );
     }
 
-    void AIToPrimarySkillObject( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index )
+    void AIToPrimarySkillObject( Heroes & hero, const MP2::MapObjectType objectType, s32 dst_index, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         const Maps::Tiles & tile = world.GetTiles( dst_index );
 
@@ -1010,12 +1012,12 @@ namespace AI
             break;
         case MP2::OBJ_ARENA:
             if ( Settings::Get().ExtHeroArenaCanChoiseAnySkills() )
-                skill = AISelectPrimarySkill( hero );
+                skill = AISelectPrimarySkill( hero, randomGenerator );
             else {
-                switch ( Rand::Get( 1, 3 ) ) {
+                switch ( randomGenerator.Get( 1, 3 ) ) {
                 case 1:
                 case 2:
-                    skill = Rand::Get( 1 ) ? Skill::Primary::ATTACK : Skill::Primary::DEFENSE;
+                    skill = randomGenerator.Get( 1 ) ? Skill::Primary::ATTACK : Skill::Primary::DEFENSE;
                     break;
 
                 default:
@@ -1618,6 +1620,9 @@ namespace AI
             left.GetBagArtifacts().exchangeArtifacts( right.GetBagArtifacts() );
         else
             right.GetBagArtifacts().exchangeArtifacts( left.GetBagArtifacts() );
+
+        left.invalidateStats();
+        right.invalidateStats();
     }
 
     void HeroesMove( Heroes & hero )
@@ -1724,7 +1729,7 @@ namespace AI
         }
     }
 
-    void AIWhirlpoolTroopLooseEffect( Heroes & hero )
+    void AIWhirlpoolTroopLooseEffect( Heroes & hero, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         Troop * troop = hero.GetArmy().GetWeakestTroop();
         assert( troop );
@@ -1736,7 +1741,7 @@ namespace AI
             return;
         }
 
-        if ( 1 == Rand::Get( 1, 3 ) ) {
+        if ( 1 == randomGenerator.Get( 1, 3 ) ) {
             if ( troop->GetCount() == 1 ) {
                 troop->Reset();
             }
@@ -1793,6 +1798,8 @@ namespace AI
                     artifact = Artifact::UNKNOWN;
                 }
             }
+
+            hero.invalidateStats();
         }
 
         DEBUG_LOG( DBG_GAME, DBG_INFO, hero.GetName() << " visited Alchemist Tower to remove " << cursed << " artifacts." );
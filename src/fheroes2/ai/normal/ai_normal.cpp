@@ -28,6 +28,9 @@ namespace AI
         : _pathfinder( ARMY_STRENGTH_ADVANTAGE_LARGE )
     {
         _personality = Rand::Get( AI::WARRIOR, AI::EXPLORER );
+
+        // Objects which are further away are evaluated by the region-level pathfinder
+        _pathfinder.setSearchDayLimit( HERO_SEARCH_DAY_LIMIT );
     }
 
     void Normal::resetPathfinder()
@@ -21,7 +21,10 @@
 #ifndef H2AI_NORMAL_H
 #define H2AI_NORMAL_H
 
+#include <set>
+
 #include "ai.h"
+#include "ai_battle_estimator.h"
 #include "world_pathfinding.h"
 
 namespace Battle
@@ -126,9 +129,9 @@ namespace AI
     public:
         Normal();
         void KingdomTurn( Kingdom & kingdom ) override;
-        void CastleTurn( Castle & castle, bool defensive ) override;
+        void CastleTurn( Castle & castle, bool defensive, const Rand::DeterministicRandomGenerator & randomGenerator ) override;
         void BattleTurn( Battle::Arena & arena, const Battle::Unit & currentUnit, Battle::Actions & actions ) override;
-        bool HeroesTurn( VecHeroes & heroes ) override;
+        bool HeroesTurn( VecHeroes & heroes, const Rand::DeterministicRandomGenerator & randomGenerator ) override;
 
         void revealFog( const Maps::Tiles & tile ) override;
 
@@ -146,6 +149,13 @@ namespace AI
         std::vector<RegionStats> _regions;
         AIWorldPathfinder _pathfinder;
         BattlePlanner _battlePlanner;
+        BattleEstimator _battleEstimator;
+        // Targets where battles are likely to be lost, as pairs of the hero ID and the tile index
+        std::set<std::pair<int, int> > _lostBattleTargets;
+
+        // Returns false if the hero is likely to lose the battle at the target. The battle is played by the estimator only if
+        // the outcome is not clear from the army strength.
+        bool isBattleTargetWinnable( Heroes & hero, const int targetIndex );
 
         double getHunterObjectValue( const Heroes & hero, const int index, const double valueToIgnore, const uint32_t distanceToObject ) const;
 
@@ -24,6 +24,7 @@
 #include "battle_army.h"
 #include "battle_cell.h"
 #include "battle_command.h"
+#include "battle_snapshot.h"
 #include "battle_tower.h"
 #include "battle_troop.h"
 #include "castle.h"
@@ -47,6 +48,8 @@ namespace AI
     // 20% of maximum value lost for every tile travelled to make sure 4 tiles difference matters
     const double STRENGTH_DISTANCE_FACTOR = 5.0;
     const std::vector<int> underWallsIndicies = { 7, 28, 49, 72, 95 };
+    // Number of random damage and luck rolls used to estimate the outcome of a single attack
+    const uint32_t ATTACK_ROLLOUTS = 8;
 
     struct MeleeAttackOutcome
     {
@@ -101,6 +104,24 @@ namespace AI
         return bestOutcome;
     }
 
+    // Returns the average change of the difference between the strengths of the attacker's army and the enemy army after the attack,
+    // including the retaliation and the second strike. Every rollout is played on its own copy of the snapshot.
+    double AttackStrengthBalance( const Snapshot & snapshot, const int32_t attackerId, const int32_t defenderId, std::mt19937 & gen )
+    {
+        const int mySide = snapshot.getUnit( attackerId ).side;
+        const int enemySide = 1 - mySide;
+        const double initialBalance = snapshot.getStrength( mySide ) - snapshot.getStrength( enemySide );
+
+        double balance = 0;
+        for ( uint32_t i = 0; i < ATTACK_ROLLOUTS; ++i ) {
+            Snapshot rollout( snapshot );
+            rollout.attack( attackerId, defenderId, &gen );
+            balance += rollout.getStrength( mySide ) - rollout.getStrength( enemySide );
+        }
+
+        return balance / ATTACK_ROLLOUTS - initialBalance;
+    }
+
     int32_t FindMoveToRetreat( const Indexes & moves, const Unit & currentUnit, const Battle::Units & enemies )
     {
         double lowestThreat = 0.0;
@@ -449,18 +470,32 @@ namespace AI
         if ( currentUnit.isHandFighting() ) {
             // Current ranged unit is blocked by the enemy
 
+            // Every attack is played out on a copy of the battle state so the retaliation, the second strike and the luck are taken into account
+            const Snapshot snapshot( arena );
+            const int32_t currentUnitId = snapshot.findUnit( currentUnit.GetUID() );
+            assert( currentUnitId != -1 );
+
+            std::mt19937 gen( _randomGenerator->Get( 0, UINT32_MAX ) );
+
             // Force archer to fight back by setting initial expectation to lowest possible (if we're losing battle)
-            int bestOutcome = ( _myArmyStrength < _enemyArmyStrength ) ? -_highestDamageExpected : 0;
+            double bestOutcome = 0;
+            if ( _myArmyStrength < _enemyArmyStrength ) {
+                bestOutcome = -currentUnit.GetMonsterStrength() * _highestDamageExpected / currentUnit.Monster::GetHitPoints();
+            }
 
             const Indexes & adjacentEnemies = Board::GetAdjacentEnemies( currentUnit );
             for ( const int cell : adjacentEnemies ) {
                 const Unit * enemy = Board::GetCell( cell )->GetUnit();
                 if ( enemy ) {
-                    const int archerMeleeDmg = currentUnit.GetDamage( *enemy );
-                    const int damageDiff = archerMeleeDmg - enemy->CalculateRetaliationDamage( archerMeleeDmg );
+                    const int32_t enemyId = snapshot.findUnit( enemy->GetUID() );
+                    if ( enemyId == -1 ) {
+                        continue;
+                    }
+
+                    const double outcome = AttackStrengthBalance( snapshot, currentUnitId, enemyId, gen );
 
-                    if ( bestOutcome < damageDiff ) {
-                        bestOutcome = damageDiff;
+                    if ( bestOutcome < outcome ) {
+                        bestOutcome = outcome;
                         target.unit = enemy;
                         target.cell = cell;
                     }
@@ -497,20 +532,19 @@ namespace AI
             // Normal ranged attack: focus the highest value unit
             double highestStrength = 0;
 
+            const Board & board = *Arena::GetBoard();
+            const Bitboard occupiedCells = board.GetOccupiedMask();
+
             for ( const Unit * enemy : enemies ) {
                 double attackPriority = enemy->GetScoreQuality( currentUnit );
 
                 if ( currentUnit.isAbilityPresent( fheroes2::MonsterAbilityType::AREA_SHOT ) ) {
                     // TODO: update logic to handle tail case as well. Right now archers always shoot to head.
-                    const Indexes around = Board::GetAroundIndexes( enemy->GetHeadIndex() );
                     std::set<const Unit *> targetedUnits;
 
-                    for ( const int32_t cellId : around ) {
-                        const Unit * monsterOnCell = Board::GetCell( cellId )->GetUnit();
-                        if ( monsterOnCell != nullptr ) {
-                            targetedUnits.emplace( monsterOnCell );
-                        }
-                    }
+                    ( Bitboard::getAroundMask( enemy->GetHeadIndex() ) & occupiedCells ).forEach( [&board, &targetedUnits]( const int32_t cellId ) {
+                        targetedUnits.emplace( board[cellId].GetUnit() );
+                    } );
 
                     for ( const Unit * monster : targetedUnits ) {
                         if ( enemy != monster ) {
@@ -117,30 +117,30 @@ namespace AI
         return genericBuildOrder;
     }
 
-    bool Build( Castle & castle, const std::vector<BuildOrder> & buildOrderList, int multiplier = 1 )
+    bool Build( Castle & castle, const std::vector<BuildOrder> & buildOrderList, const Rand::DeterministicRandomGenerator & randomGenerator, int multiplier = 1 )
     {
         for ( std::vector<BuildOrder>::const_iterator it = buildOrderList.begin(); it != buildOrderList.end(); ++it ) {
             const int priority = it->priority * multiplier;
             if ( priority == 1 ) {
-                if ( BuildIfAvailable( castle, it->building ) )
+                if ( BuildIfAvailable( castle, it->building, randomGenerator ) )
                     return true;
             }
             else {
-                if ( BuildIfEnoughResources( castle, it->building, GetResourceMultiplier( castle, priority, priority + 1 ) ) )
+                if ( BuildIfEnoughResources( castle, it->building, GetResourceMultiplier( castle, priority, priority + 1, randomGenerator ), randomGenerator ) )
                     return true;
             }
         }
         return false;
     }
 
-    bool CastleDevelopment( Castle & castle )
+    bool CastleDevelopment( Castle & castle, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         if ( !castle.isBuild( BUILD_WELL ) && world.LastDay() ) {
             // return right away - if you can't buy Well you can't buy anything else
-            return BuildIfAvailable( castle, BUILD_WELL );
+            return BuildIfAvailable( castle, BUILD_WELL, randomGenerator );
         }
 
-        if ( Build( castle, GetIncomeStructures( castle.GetRace() ) ) ) {
+        if ( Build( castle, GetIncomeStructures( castle.GetRace() ), randomGenerator ) ) {
             return true;
         }
 
@@ -148,11 +148,11 @@ namespace AI
         const bool islandOrPeninsula = neighbourRegions < 3;
 
         // force building a shipyard, +1 to cost check since we can have 0 neighbours
-        if ( islandOrPeninsula && BuildIfEnoughResources( castle, BUILD_SHIPYARD, static_cast<uint32_t>( neighbourRegions + 1 ) ) ) {
+        if ( islandOrPeninsula && BuildIfEnoughResources( castle, BUILD_SHIPYARD, static_cast<uint32_t>( neighbourRegions + 1 ), randomGenerator ) ) {
             return true;
         }
 
-        if ( Build( castle, GetBuildOrder( castle.GetRace() ) ) ) {
+        if ( Build( castle, GetBuildOrder( castle.GetRace() ), randomGenerator ) ) {
             return true;
         }
 
@@ -160,19 +160,19 @@ namespace AI
         if ( castle.GetKingdom().GetFunds() >= PaymentConditions::BuyBoat() * ( islandOrPeninsula ? 2 : 4 ) )
             castle.BuyBoat();
 
-        return Build( castle, GetDefensiveStructures(), 10 );
+        return Build( castle, GetDefensiveStructures(), randomGenerator, 10 );
     }
 
-    void Normal::CastleTurn( Castle & castle, bool defensive )
+    void Normal::CastleTurn( Castle & castle, bool defensive, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
         if ( defensive ) {
-            Build( castle, GetDefensiveStructures() );
+            Build( castle, GetDefensiveStructures(), randomGenerator );
 
             castle.recruitBestAvailable( castle.GetKingdom().GetFunds() );
             OptimizeTroopsOrder( castle.GetArmy() );
         }
         else {
-            CastleDevelopment( castle );
+            CastleDevelopment( castle, randomGenerator );
         }
     }
 }
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <limits>
 
 #include "ai_normal.h"
 #include "game.h"
@@ -29,6 +30,7 @@
 #include "maps.h"
 #include "morale.h"
 #include "mp2.h"
+#include "profiler.h"
 #include "settings.h"
 #include "world.h"
 
@@ -546,6 +548,9 @@ namespace
 
     const double dangerousTaskPenalty = 20000.0;
 
+    // Heroes do not attack if the estimated chance to win the battle is lower
+    const double minimalWinProbability = 0.5;
+
     double ScaleWithDistance( double value, uint32_t distance )
     {
         if ( distance == 0 )
@@ -553,6 +558,20 @@ namespace
         // scale non-linearly (more value lost as distance increases)
         return value - ( distance * std::log10( distance ) );
     }
+
+    // Returns the furthest tile of the region-level route to the target which the hero can reach according to the pathfinder or -1 if there is no such tile
+    int getRegionRouteWaypoint( const Heroes & hero, const int targetIndex, const AIWorldPathfinder & pathfinder )
+    {
+        const std::vector<int> route = world.getRegionRoute( hero.GetIndex(), targetIndex, static_cast<uint8_t>( hero.GetLevelSkill( Skill::Secondary::PATHFINDING ) ) );
+
+        for ( auto it = route.rbegin(); it != route.rend(); ++it ) {
+            if ( pathfinder.getDistance( *it ) > 0 ) {
+                return *it;
+            }
+        }
+
+        return -1;
+    }
 }
 
 namespace AI
@@ -1065,6 +1084,10 @@ namespace AI
         // pre-cache the pathfinder
         _pathfinder.reEvaluateIfNeeded( hero );
 
+        // Objects beyond the limit of the pathfinder are scored by the region-level lower bound of the distance
+        const bool isSearchLimitReached = _pathfinder.isSearchLimitReached();
+        const uint32_t searchCostLimit = _pathfinder.getSearchCostLimit();
+
         const uint32_t leftMovePoints = hero.GetMovePoints();
 
         ObjectValidator objectValidator( hero, _pathfinder );
@@ -1077,20 +1100,36 @@ namespace AI
             if ( heroInPatrolMode && Maps::GetApproximateDistance( node.first, patrolIndex ) > distanceLimit )
                 continue;
 
+            if ( !_lostBattleTargets.empty() && _lostBattleTargets.count( std::make_pair( hero.GetID(), node.first ) ) > 0 )
+                continue;
+
             if ( objectValidator.isValid( node.first ) ) {
                 uint32_t dist = _pathfinder.getDistance( node.first );
-                if ( dist == 0 )
-                    continue;
+                bool isDistantObject = false;
+
+                if ( dist == 0 ) {
+                    if ( !isSearchLimitReached )
+                        continue;
+
+                    // Objects which might be within the limit but have not been reached are most likely blocked
+                    dist = world.getMinimumRegionDistance( hero.GetIndex(), node.first );
+                    if ( dist <= searchCostLimit || dist == std::numeric_limits<uint32_t>::max() )
+                        continue;
+
+                    isDistantObject = true;
+                }
 
                 double value = valueStorage.value( node, dist );
 
-                const std::vector<IndexObject> & list = _pathfinder.getObjectsOnTheWay( node.first );
-                for ( const IndexObject & pair : list ) {
-                    if ( objectValidator.isValid( pair.first ) && std::binary_search( _mapObjects.begin(), _mapObjects.end(), pair ) ) {
-                        const double extraValue = valueStorage.value( pair, 0 ); // object is on the way, we don't loose any movement points.
-                        if ( extraValue > 0 ) {
-                            // There is no need to reduce the quality of the object even if the path has others.
-                            value += extraValue;
+                if ( !isDistantObject ) {
+                    const std::vector<IndexObject> & list = _pathfinder.getObjectsOnTheWay( node.first );
+                    for ( const IndexObject & pair : list ) {
+                        if ( objectValidator.isValid( pair.first ) && std::binary_search( _mapObjects.begin(), _mapObjects.end(), pair ) ) {
+                            const double extraValue = valueStorage.value( pair, 0 ); // object is on the way, we don't loose any movement points.
+                            if ( extraValue > 0 ) {
+                                // There is no need to reduce the quality of the object even if the path has others.
+                                value += extraValue;
+                            }
                         }
                     }
                 }
@@ -1113,8 +1152,17 @@ namespace AI
                 value = ScaleWithDistance( value, dist );
 
                 if ( dist && value > maxPriority ) {
+                    int targetIndex = node.first;
+
+                    if ( isDistantObject ) {
+                        // The hero moves along the region-level route and the rest of it is planned on the next turns
+                        targetIndex = getRegionRouteWaypoint( hero, node.first, _pathfinder );
+                        if ( targetIndex == -1 )
+                            continue;
+                    }
+
                     maxPriority = value;
-                    priorityTarget = node.first;
+                    priorityTarget = targetIndex;
 #ifdef WITH_DEBUG
                     objectType = static_cast<MP2::MapObjectType>( node.second );
 #endif
@@ -1138,6 +1186,40 @@ namespace AI
         return priorityTarget;
     }
 
+    bool Normal::isBattleTargetWinnable( Heroes & hero, const int targetIndex )
+    {
+        const Maps::Tiles & tile = world.GetTiles( targetIndex );
+        const MP2::MapObjectType objectType = tile.GetObject();
+
+        Army & army = hero.GetArmy();
+
+        if ( objectType == MP2::OBJ_MONSTER ) {
+            Army enemy( tile );
+            if ( army.GetStrength() > enemy.GetStrength() * ARMY_STRENGTH_ADVANTAGE_LARGE )
+                return true;
+
+            return _battleEstimator.estimate( army, enemy, targetIndex ).winProbability >= minimalWinProbability;
+        }
+
+        Army * enemy = nullptr;
+
+        if ( objectType == MP2::OBJ_HEROES ) {
+            Heroes * enemyHero = tile.GetHeroes();
+            if ( enemyHero && !Players::isFriends( hero.GetColor(), enemyHero->GetColor() ) )
+                enemy = &enemyHero->GetArmy();
+        }
+        else if ( objectType == MP2::OBJ_CASTLE ) {
+            Castle * castle = world.getCastleEntrance( Maps::GetPoint( targetIndex ) );
+            if ( castle && !Players::isFriends( hero.GetColor(), castle->GetColor() ) )
+                enemy = &castle->GetActualArmy();
+        }
+
+        if ( enemy == nullptr || army.GetStrength() > enemy->GetStrength() * ARMY_STRENGTH_ADVANTAGE_LARGE )
+            return true;
+
+        return _battleEstimator.estimate( army, *enemy, targetIndex ).winProbability >= minimalWinProbability;
+    }
+
     void Normal::HeroesActionComplete( Heroes & hero )
     {
         Castle * castle = hero.inCastleMutable();
@@ -1146,8 +1228,10 @@ namespace AI
         }
     }
 
-    bool Normal::HeroesTurn( VecHeroes & heroes )
+    bool Normal::HeroesTurn( VecHeroes & heroes, const Rand::DeterministicRandomGenerator & randomGenerator )
     {
+        PROFILE_ZONE( "AI::HeroesTurn" );
+
         if ( heroes.empty() ) {
             // No heroes so we idicate that all heroes moved.
             return true;
@@ -1181,7 +1265,18 @@ namespace AI
                 }
 
                 if ( bestTargetIndex != -1 ) {
-                    break;
+                    if ( isBattleTargetWinnable( *bestHero, bestTargetIndex ) ) {
+                        break;
+                    }
+
+                    // The battle at the target is likely to be lost, look for another one.
+                    DEBUG_LOG( DBG_AI, DBG_INFO, bestHero->GetName() << " is likely to lose the battle at " << bestTargetIndex );
+
+                    _lostBattleTargets.emplace( bestHero->GetID(), bestTargetIndex );
+                    bestHero = availableHeroes.front().hero;
+                    maxPriority = 0;
+                    bestTargetIndex = -1;
+                    continue;
                 }
 
                 // If nowhere to move perhaps it's because of high monster estimation. Let's reduce it.
@@ -1231,6 +1326,7 @@ namespace AI
 
             _pathfinder.reEvaluateIfNeeded( *bestHero );
             bestHero->GetPath().setPath( _pathfinder.buildPath( bestTargetIndex ), bestTargetIndex );
+            logAction( ActionType::HERO_TARGET, bestHero->GetColor(), bestHero->GetID(), bestTargetIndex, randomGenerator.GetSeed() );
 
             const size_t heroesBefore = heroes.size();
 
@@ -23,10 +23,12 @@
 #include "agg.h"
 #include "ai_normal.h"
 #include "game_interface.h"
+#include "game_session.h"
 #include "ground.h"
 #include "kingdom.h"
 #include "logging.h"
 #include "mus.h"
+#include "profiler.h"
 #include "world.h"
 
 namespace
@@ -66,6 +68,13 @@ namespace
             }
         }
     }
+
+    void redrawTurnProgress( const bool isHeadless, const uint32_t progress )
+    {
+        if ( !isHeadless ) {
+            Interface::Basic::Get().GetStatusWindow().RedrawTurnProgress( progress );
+        }
+    }
 }
 
 namespace AI
@@ -74,39 +83,60 @@ namespace AI
     {
         const int color = kingdom.GetColor();
 
+        PROFILE_REPORT( "AI turn of " + Color::String( color ) );
+        PROFILE_ZONE( "AI::KingdomTurn" );
+
         if ( kingdom.isLoss() || color == Color::NONE ) {
             kingdom.LossPostActions();
             return;
         }
 
+        // Headless game sessions have no user interface
+        const bool isHeadless = Game::Session::Get().isHeadless();
+
         // reset indicator
-        Interface::StatusWindow & status = Interface::Basic::Get().GetStatusWindow();
-        status.RedrawTurnProgress( 0 );
+        redrawTurnProgress( isHeadless, 0 );
 
-        AGG::PlayMusic( MUS::COMPUTER_TURN, true, true );
+        if ( !isHeadless ) {
+            AGG::PlayMusic( MUS::COMPUTER_TURN, true, true );
+        }
 
         KingdomHeroes & heroes = kingdom.GetHeroes();
         KingdomCastles & castles = kingdom.GetCastles();
 
+        // All decisions of the turn draw their random values from the streams of the game so they do not depend on other parts of the game.
+        const Rand::DeterministicRandomGenerator & castleRandomGenerator = world.getRandomGenerator( World::RandomStream::AI_CASTLE );
+        const Rand::DeterministicRandomGenerator & heroRandomGenerator = world.getRandomGenerator( World::RandomStream::AI_HERO_ACTION );
+        const HeroActionRandomScope heroActionRandomScope( *this, heroRandomGenerator );
+
         DEBUG_LOG( DBG_AI, DBG_INFO, Color::String( color ) << " starts the turn: " << castles.size() << " castles, " << heroes.size() << " heroes" );
         DEBUG_LOG( DBG_AI, DBG_TRACE, "Funds: " << kingdom.GetFunds().String() );
 
         // Step 1. Scan visible map (based on game difficulty), add goals and threats
         std::vector<std::pair<int, const Army *> > enemyArmies;
 
-        const int mapSize = world.w() * world.h();
         _mapObjects.clear();
         _regions.clear();
+        _battleEstimator.clear();
+        _lostBattleTargets.clear();
         _regions.resize( world.getRegionCount() );
 
-        for ( int idx = 0; idx < mapSize; ++idx ) {
+        // Visible monsters of regions where some monsters are hidden or not valid for the kingdom.
+        std::vector<int32_t> visibleMonsters;
+        std::vector<uint8_t> hasSkippedMonsters( _regions.size(), 0 );
+
+        for ( const int32_t idx : world.getActionObjectTiles() ) {
             const Maps::Tiles & tile = world.GetTiles( idx );
             const MP2::MapObjectType objectType = tile.GetObject();
 
-            if ( !kingdom.isValidKingdomObject( tile, objectType ) )
+            const uint32_t regionID = tile.GetRegion();
+
+            if ( !kingdom.isValidKingdomObject( tile, objectType ) ) {
+                if ( objectType == MP2::OBJ_MONSTER && regionID < hasSkippedMonsters.size() )
+                    hasSkippedMonsters[regionID] = 1;
                 continue;
+            }
 
-            const uint32_t regionID = tile.GetRegion();
             if ( regionID >= _regions.size() ) {
                 // shouldn't be possible, assert
                 assert( regionID < _regions.size() );
@@ -153,18 +183,35 @@ namespace AI
                     }
                 }
                 else if ( objectType == MP2::OBJ_MONSTER ) {
-                    stats.averageMonster += Army( tile ).GetStrength();
+                    visibleMonsters.push_back( idx );
                     ++stats.monsterCount;
                 }
             }
             else {
                 ++stats.fogCount;
+
+                if ( objectType == MP2::OBJ_MONSTER )
+                    hasSkippedMonsters[regionID] = 1;
             }
         }
 
+        // Strength of all monsters of a region is calculated by the world and reused between turns.
+        const std::vector<World::RegionObjectSummary> & regionSummaries = world.getRegionObjectSummaries();
+        for ( size_t regionID = 0; regionID < _regions.size() && regionID < regionSummaries.size(); ++regionID ) {
+            if ( !hasSkippedMonsters[regionID] )
+                _regions[regionID].averageMonster += regionSummaries[regionID].monsterStrength;
+        }
+
+        for ( const int32_t idx : visibleMonsters ) {
+            const Maps::Tiles & tile = world.GetTiles( idx );
+            const uint32_t regionID = tile.GetRegion();
+            if ( regionID >= regionSummaries.size() || hasSkippedMonsters[regionID] )
+                _regions[regionID].averageMonster += Army( tile ).GetStrength();
+        }
+
         DEBUG_LOG( DBG_AI, DBG_TRACE, Color::String( color ) << " found " << _mapObjects.size() << " valid objects" );
 
-        status.RedrawTurnProgress( 1 );
+        redrawTurnProgress( isHeadless, 1 );
 
         // Step 2. Update AI variables and recalculate resource budget
         const bool slowEarlyGame = world.CountDay() < 5 && castles.size() == 1;
@@ -196,6 +243,10 @@ namespace AI
 
                     const double attackerThreat = attackerStrength - defenders;
                     if ( attackerThreat > 0 ) {
+                        // No army can move faster than the region-level lower bound so a full map search is needed only for armies which might be close enough.
+                        if ( world.getMinimumRegionDistance( enemy->first, castleIndex ) >= threatDistanceLimit )
+                            continue;
+
                         const uint32_t dist = _pathfinder.getDistance( enemy->first, castleIndex, color, attackerStrength );
                         if ( dist && dist < threatDistanceLimit ) {
                             // castle is under threat
@@ -221,9 +272,9 @@ namespace AI
 
         setHeroRoles( heroes );
 
-        const bool moreTasksForHeroes = HeroesTurn( heroes );
+        const bool moreTasksForHeroes = HeroesTurn( heroes, heroRandomGenerator );
 
-        status.RedrawTurnProgress( 6 );
+        redrawTurnProgress( isHeadless, 6 );
 
         // Step 4. Buy new heroes, adjust roles, sort heroes based on priority or strength
 
@@ -274,21 +325,25 @@ namespace AI
                     recruit = recruitmentCastle->RecruitHero( firstRecruit );
                 }
 
+                if ( recruit ) {
+                    logAction( ActionType::RECRUIT_HERO, kingdom.GetColor(), recruitmentCastle->GetIndex(), recruit->GetID(), castleRandomGenerator.GetSeed() );
+                }
+
                 if ( recruit && !slowEarlyGame ) {
-                    CastleTurn( *recruitmentCastle, castlesInDanger.find( recruitmentCastle->GetIndex() ) != castlesInDanger.end() );
+                    CastleTurn( *recruitmentCastle, castlesInDanger.find( recruitmentCastle->GetIndex() ) != castlesInDanger.end(), castleRandomGenerator );
                     ReinforceHeroInCastle( *recruit, *recruitmentCastle, kingdom.GetFunds() );
                 }
             }
         }
 
-        status.RedrawTurnProgress( 7 );
+        redrawTurnProgress( isHeadless, 7 );
 
         // Step 5. Move newly hired heroes if any.
         setHeroRoles( heroes );
 
-        HeroesTurn( heroes );
+        HeroesTurn( heroes, heroRandomGenerator );
 
-        status.RedrawTurnProgress( 9 );
+        redrawTurnProgress( isHeadless, 9 );
 
         // sync up castle list (if conquered new ones during the turn)
         if ( castles.size() != sortedCastleList.size() ) {
@@ -299,7 +354,7 @@ namespace AI
         // Step 6. Castle development according to kingdom budget
         for ( Castle * castle : sortedCastleList ) {
             if ( castle != nullptr ) {
-                CastleTurn( *castle, castlesInDanger.find( castle->GetIndex() ) != castlesInDanger.end() );
+                CastleTurn( *castle, castlesInDanger.find( castle->GetIndex() ) != castlesInDanger.end(), castleRandomGenerator );
             }
         }
     }
@@ -990,22 +990,70 @@ void Army::SetColor( int cl )
 }
 
 int Army::GetLuck( void ) const
+{
+    _updateStatsCache();
+    return _getCachedLuck();
+}
+
+int Army::_calculateLuck() const
 {
     const HeroBase * currentCommander = GetCommander();
     return currentCommander != nullptr ? currentCommander->GetLuck() : GetLuckModificator( nullptr );
 }
 
+int Army::_getCachedLuck() const
+{
+    if ( !_statsCache.isLuckValid ) {
+        _statsCache.luck = _calculateLuck();
+        _statsCache.isLuckValid = true;
+    }
+#ifdef WITH_DEBUG
+    else if ( IS_DEVEL() ) {
+        const int luck = _calculateLuck();
+        if ( luck != _statsCache.luck ) {
+            ERROR_LOG( "cached luck " << _statsCache.luck << " differs from the actual value " << luck << " for army: " << String() )
+        }
+    }
+#endif
+
+    return _statsCache.luck;
+}
+
 int Army::GetLuckModificator( const std::string * ) const
 {
     return Luck::NORMAL;
 }
 
 int Army::GetMorale( void ) const
+{
+    _updateStatsCache();
+    return _getCachedMorale();
+}
+
+int Army::_calculateMorale() const
 {
     const HeroBase * currentCommander = GetCommander();
     return currentCommander != nullptr ? currentCommander->GetMorale() : GetMoraleModificator( nullptr );
 }
 
+int Army::_getCachedMorale() const
+{
+    if ( !_statsCache.isMoraleValid ) {
+        _statsCache.morale = _calculateMorale();
+        _statsCache.isMoraleValid = true;
+    }
+#ifdef WITH_DEBUG
+    else if ( IS_DEVEL() ) {
+        const int morale = _calculateMorale();
+        if ( morale != _statsCache.morale ) {
+            ERROR_LOG( "cached morale " << _statsCache.morale << " differs from the actual value " << morale << " for army: " << String() )
+        }
+    }
+#endif
+
+    return _statsCache.morale;
+}
+
 int Army::GetMoraleModificator( std::string * strs ) const
 {
     // different race penalty
@@ -1070,14 +1118,35 @@ int Army::GetMoraleModificator( std::string * strs ) const
 }
 
 double Army::GetStrength() const
+{
+    _updateStatsCache();
+
+    const int armyMorale = _getCachedMorale();
+    const int armyLuck = _getCachedLuck();
+
+    if ( !_statsCache.isStrengthValid ) {
+        _statsCache.strength = _calculateStrength( armyMorale, armyLuck );
+        _statsCache.isStrengthValid = true;
+    }
+#ifdef WITH_DEBUG
+    else if ( IS_DEVEL() ) {
+        const double strength = _calculateStrength( armyMorale, armyLuck );
+        if ( std::fabs( strength - _statsCache.strength ) > 0.001 ) {
+            ERROR_LOG( "cached strength " << _statsCache.strength << " differs from the actual value " << strength << " for army: " << String() )
+        }
+    }
+#endif
+
+    return _statsCache.strength;
+}
+
+double Army::_calculateStrength( const int armyMorale, const int armyLuck ) const
 {
     double result = 0;
     const uint32_t archery = ( commander ) ? commander->GetSecondaryValues( Skill::Secondary::ARCHERY ) : 0;
     // Hero bonus calculation is slow, cache it
     const int bonusAttack = ( commander ? commander->GetAttack() : 0 );
     const int bonusDefense = ( commander ? commander->GetDefense() : 0 );
-    const int armyMorale = GetMorale();
-    const int armyLuck = GetLuck();
 
     for ( const_iterator it = begin(); it != end(); ++it ) {
         const Troop * troop = *it;
@@ -1105,6 +1174,21 @@ double Army::GetStrength() const
     return result;
 }
 
+void Army::_updateStatsCache() const
+{
+    const uint32_t commanderStatsVersion = commander ? commander->getStatsVersion() : 0;
+    const bool isCommanderValid = commander && commander->isValid();
+
+    if ( _statsCache.troopsVersion != _troopsVersion || _statsCache.commander != commander || _statsCache.commanderStatsVersion != commanderStatsVersion
+         || _statsCache.isCommanderValid != isCommanderValid ) {
+        _statsCache = StatsCache();
+        _statsCache.commander = commander;
+        _statsCache.troopsVersion = _troopsVersion;
+        _statsCache.commanderStatsVersion = commanderStatsVersion;
+        _statsCache.isCommanderValid = isCommanderValid;
+    }
+}
+
 void Army::Reset( bool soft )
 {
     Troops::Clean();
@@ -1367,7 +1451,10 @@ bool Army::FastestTroop( const Troop * t1, const Troop * t2 )
 
 void Army::SwapTroops( Troop & t1, Troop & t2 )
 {
-    std::swap( t1, t2 );
+    // Go through the setters so the owning armies notice the change
+    const Troop temp( t1 );
+    t1.Set( t2 );
+    t2.Set( temp );
 }
 
 bool Army::SaveLastTroop( void ) const
@@ -1425,6 +1512,8 @@ StreamBase & operator>>( StreamBase & msg, Army & army )
 
     // set later from owner (castle, heroes)
     army.commander = nullptr;
+    ++army._troopsVersion;
+    army._statsCache = Army::StatsCache();
 
     return msg;
 }
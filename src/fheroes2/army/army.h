@@ -167,6 +167,13 @@ public:
     int GetLuck( void ) const;
     int GetMoraleModificator( std::string * ) const;
     int GetLuckModificator( const std::string * ) const;
+
+    // Returns the version of the troops which changes on every change of a monster or a count of any troop of the army.
+    uint32_t getTroopsVersion() const
+    {
+        return _troopsVersion;
+    }
+
     u32 ActionToSirens( void );
 
     const HeroBase * GetCommander( void ) const;
@@ -196,6 +203,38 @@ protected:
     HeroBase * commander;
     bool combat_format;
     int color;
+
+private:
+    friend class ArmyTroop;
+
+    // Bumped by troops of the army on every change, see ArmyTroop::onChange().
+    mutable uint32_t _troopsVersion = 0;
+
+    // Strength, morale and luck of the army are requested very often by AI while being expensive to calculate.
+    // Cached values are valid as long as the troops, the commander and the stats version of the commander stay the same.
+    struct StatsCache
+    {
+        const HeroBase * commander = nullptr;
+        uint32_t troopsVersion = 0;
+        uint32_t commanderStatsVersion = 0;
+        bool isCommanderValid = false;
+        bool isStrengthValid = false;
+        bool isMoraleValid = false;
+        bool isLuckValid = false;
+        double strength = 0;
+        int morale = 0;
+        int luck = 0;
+    };
+
+    mutable StatsCache _statsCache;
+
+    void _updateStatsCache() const;
+    int _getCachedMorale() const;
+    int _getCachedLuck() const;
+
+    int _calculateMorale() const;
+    int _calculateLuck() const;
+    double _calculateStrength( const int armyMorale, const int armyLuck ) const;
 };
 
 StreamBase & operator<<( StreamBase &, const Army & );
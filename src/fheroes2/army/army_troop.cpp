@@ -65,17 +65,26 @@ void Troop::Set( const Monster & m, u32 c )
 void Troop::SetMonster( const Monster & m )
 {
     id = m.GetID();
+    onChange();
 }
 
 void Troop::SetCount( u32 c )
 {
     count = c;
+    onChange();
 }
 
 void Troop::Reset( void )
 {
     id = Monster::UNKNOWN;
     count = 0;
+    onChange();
+}
+
+void Troop::Upgrade( void )
+{
+    Monster::Upgrade();
+    onChange();
 }
 
 const char * Troop::GetName( void ) const
@@ -213,6 +222,12 @@ int ArmyTroop::GetLuck( void ) const
     return army ? army->GetLuck() : Troop::GetLuck();
 }
 
+void ArmyTroop::onChange()
+{
+    if ( army )
+        ++army->_troopsVersion;
+}
+
 void ArmyTroop::SetArmy( const Army & a )
 {
     army = &a;
@@ -42,6 +42,7 @@ public:
     void SetMonster( const Monster & );
     void SetCount( u32 );
     void Reset( void );
+    void Upgrade( void );
 
     bool isMonster( int ) const;
     const char * GetName( void ) const;
@@ -73,6 +74,9 @@ protected:
     friend StreamBase & operator<<( StreamBase &, const Troop & );
     friend StreamBase & operator>>( StreamBase &, Troop & );
 
+    // Called after every change of the monster or the count of the troop
+    virtual void onChange() {}
+
     u32 count;
 };
 
@@ -100,6 +104,8 @@ public:
     std::string GetDefenseString( void ) const override;
 
 protected:
+    void onChange() override;
+
     const Army * army;
 };
 
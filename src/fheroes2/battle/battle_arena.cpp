@@ -40,6 +40,7 @@
 #include "ground.h"
 #include "icn.h"
 #include "logging.h"
+#include "profiler.h"
 #include "race.h"
 #include "settings.h"
 #include "spell_info.h"
@@ -49,7 +50,8 @@
 
 namespace Battle
 {
-    Arena * arena = nullptr;
+    // A battle is played entirely by one thread. Game sessions on different threads have their own battles.
+    thread_local Arena * arena = nullptr;
 }
 
 namespace
@@ -403,6 +405,8 @@ bool Battle::Arena::BattleValid( void ) const
 
 void Battle::Arena::Turns( void )
 {
+    PROFILE_ZONE( "Arena::Turns" );
+
     ++current_turn;
 
     DEBUG_LOG( DBG_BATTLE, DBG_TRACE, current_turn );
@@ -0,0 +1,272 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+
+#include "battle_bitboard.h"
+#include "battle_board.h"
+
+namespace
+{
+    const int32_t directionCount = 6;
+
+    int32_t countBits( uint64_t value )
+    {
+        value = value - ( ( value >> 1 ) & 0x5555555555555555ULL );
+        value = ( value & 0x3333333333333333ULL ) + ( ( value >> 2 ) & 0x3333333333333333ULL );
+        value = ( value + ( value >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int32_t>( ( value * 0x0101010101010101ULL ) >> 56 );
+    }
+
+    int32_t directionToId( const int direction )
+    {
+        switch ( direction ) {
+        case Battle::TOP_LEFT:
+            return 0;
+        case Battle::TOP_RIGHT:
+            return 1;
+        case Battle::RIGHT:
+            return 2;
+        case Battle::BOTTOM_RIGHT:
+            return 3;
+        case Battle::BOTTOM_LEFT:
+            return 4;
+        case Battle::LEFT:
+            return 5;
+        default:
+            break;
+        }
+
+        return -1;
+    }
+
+    // Offset of the neighbouring cell for the given direction id, even rows are shifted to the right relative to odd rows
+    int32_t getNeighbourIndex( const int32_t index, const int32_t directionId )
+    {
+        const int32_t x = index % ARENAW;
+        const int32_t y = index / ARENAW;
+        const bool isOddRow = ( y % 2 ) != 0;
+
+        int32_t nx = x;
+        int32_t ny = y;
+
+        switch ( directionId ) {
+        case 0:
+            nx = isOddRow ? x - 1 : x;
+            --ny;
+            break;
+        case 1:
+            nx = isOddRow ? x : x + 1;
+            --ny;
+            break;
+        case 2:
+            ++nx;
+            break;
+        case 3:
+            nx = isOddRow ? x : x + 1;
+            ++ny;
+            break;
+        case 4:
+            nx = isOddRow ? x - 1 : x;
+            ++ny;
+            break;
+        case 5:
+            --nx;
+            break;
+        default:
+            return -1;
+        }
+
+        if ( nx < 0 || nx >= ARENAW || ny < 0 || ny >= ARENAH ) {
+            return -1;
+        }
+
+        return ny * ARENAW + nx;
+    }
+
+    uint32_t calculateDistance( const int32_t index1, const int32_t index2 )
+    {
+        const int32_t x1 = index1 % ARENAW;
+        const int32_t y1 = index1 / ARENAW;
+
+        const int32_t x2 = index2 % ARENAW;
+        const int32_t y2 = index2 / ARENAW;
+
+        const int32_t du = y2 - y1;
+        const int32_t dv = ( x2 + y2 / 2 ) - ( x1 + y1 / 2 );
+
+        if ( ( du >= 0 && dv >= 0 ) || ( du < 0 && dv < 0 ) ) {
+            return std::max( std::abs( du ), std::abs( dv ) );
+        }
+
+        return std::abs( du ) + std::abs( dv );
+    }
+
+    // All tables depend only on the board geometry so they are built once on first use
+    struct BoardTables
+    {
+        BoardTables()
+        {
+            for ( int32_t index = 0; index < ARENASIZE; ++index ) {
+                for ( int32_t dirId = 0; dirId < directionCount; ++dirId ) {
+                    const int32_t neighbour = getNeighbourIndex( index, dirId );
+                    neighbours[index][dirId] = static_cast<int8_t>( neighbour );
+
+                    if ( neighbour >= 0 ) {
+                        around[index].set( neighbour );
+                    }
+                }
+
+                for ( int32_t other = 0; other < ARENASIZE; ++other ) {
+                    distances[index][other] = static_cast<uint8_t>( calculateDistance( index, other ) );
+                }
+            }
+
+            // Every ring is the previous area expanded by one step, the expansion stops once the whole board is covered
+            std::vector<Battle::Bitboard> rings;
+            for ( int32_t index = 0; index < ARENASIZE; ++index ) {
+                Battle::Bitboard area;
+                area.set( index );
+                rings.push_back( area );
+            }
+
+            const Battle::Bitboard fullBoard = ~Battle::Bitboard();
+
+            bool isExpanded = true;
+            while ( isExpanded ) {
+                isExpanded = false;
+                distanceMasks.insert( distanceMasks.end(), rings.begin(), rings.end() );
+
+                for ( Battle::Bitboard & area : rings ) {
+                    const Battle::Bitboard previous = area;
+                    previous.forEach( [&area, this]( const int32_t cell ) { area |= around[cell]; } );
+
+                    if ( area != fullBoard ) {
+                        isExpanded = true;
+                    }
+                }
+                ++maxRadius;
+            }
+
+            // Last level always covers the whole board
+            distanceMasks.insert( distanceMasks.end(), rings.begin(), rings.end() );
+        }
+
+        std::array<std::array<int8_t, directionCount>, ARENASIZE> neighbours;
+        std::array<std::array<uint8_t, ARENASIZE>, ARENASIZE> distances;
+        std::array<Battle::Bitboard, ARENASIZE> around;
+
+        // Masks for radius R are stored at [R * ARENASIZE + index], R is in [0; maxRadius]
+        std::vector<Battle::Bitboard> distanceMasks;
+        uint32_t maxRadius = 0;
+    };
+
+    const BoardTables & getTables()
+    {
+        static const BoardTables tables;
+        return tables;
+    }
+}
+
+uint32_t Battle::Bitboard::count() const
+{
+    return static_cast<uint32_t>( countBits( _word[0] ) + countBits( _word[1] ) );
+}
+
+std::vector<int32_t> Battle::Bitboard::toIndexes() const
+{
+    std::vector<int32_t> result;
+    result.reserve( count() );
+
+    forEach( [&result]( const int32_t index ) { result.push_back( index ); } );
+
+    return result;
+}
+
+Battle::Bitboard Battle::Bitboard::operator~() const
+{
+    static_assert( ARENASIZE > 64 && ARENASIZE <= 128, "Battlefield does not fit into two words" );
+
+    Bitboard result;
+    result._word[0] = ~_word[0];
+    result._word[1] = ~_word[1] & ( ( uint64_t( 1 ) << ( ARENASIZE - 64 ) ) - 1 );
+    return result;
+}
+
+const Battle::Bitboard & Battle::Bitboard::getAroundMask( const int32_t index )
+{
+    assert( index >= 0 && index < ARENASIZE );
+
+    return getTables().around[index];
+}
+
+const Battle::Bitboard & Battle::Bitboard::getDistanceMask( const int32_t index, const uint32_t radius )
+{
+    assert( index >= 0 && index < ARENASIZE );
+
+    const BoardTables & tables = getTables();
+    return tables.distanceMasks[std::min( radius, tables.maxRadius ) * ARENASIZE + index];
+}
+
+int32_t Battle::Bitboard::getNeighbour( const int32_t index, const int direction )
+{
+    const int32_t dirId = directionToId( direction );
+    if ( dirId < 0 || index < 0 || index >= ARENASIZE ) {
+        return -1;
+    }
+
+    return getTables().neighbours[index][dirId];
+}
+
+int Battle::Bitboard::getDirection( const int32_t from, const int32_t to )
+{
+    if ( from == to ) {
+        return CENTER;
+    }
+
+    const std::array<int8_t, directionCount> & neighbours = getTables().neighbours[from];
+    for ( int32_t dirId = 0; dirId < directionCount; ++dirId ) {
+        if ( neighbours[dirId] == to ) {
+            return 1 << dirId;
+        }
+    }
+
+    return UNKNOWN;
+}
+
+uint32_t Battle::Bitboard::getDistance( const int32_t index1, const int32_t index2 )
+{
+    assert( index1 >= 0 && index1 < ARENASIZE && index2 >= 0 && index2 < ARENASIZE );
+
+    return getTables().distances[index1][index2];
+}
+
+int32_t Battle::Bitboard::_lowestBit( const uint64_t bits )
+{
+    // De Bruijn multiplication, the isolated lowest bit selects a unique 6-bit pattern
+    static const int32_t table[64] = { 0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,  62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+                                       63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6 };
+
+    assert( bits != 0 );
+    return table[( ( bits & ( ~bits + 1 ) ) * 0x03F79D71B4CB0A89ULL ) >> 58];
+}
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef H2BATTLE_BITBOARD_H
+#define H2BATTLE_BITBOARD_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Battle
+{
+    // A set of battlefield cells stored as a 128-bit mask, bit N corresponds to the cell with index N
+    class Bitboard
+    {
+    public:
+        Bitboard() = default;
+
+        void set( const int32_t index )
+        {
+            _word[index >> 6] |= uint64_t( 1 ) << ( index & 63 );
+        }
+
+        void reset( const int32_t index )
+        {
+            _word[index >> 6] &= ~( uint64_t( 1 ) << ( index & 63 ) );
+        }
+
+        bool test( const int32_t index ) const
+        {
+            return ( _word[index >> 6] >> ( index & 63 ) ) & 1;
+        }
+
+        bool empty() const
+        {
+            return ( _word[0] | _word[1] ) == 0;
+        }
+
+        uint32_t count() const;
+
+        // Returns the indexes of all set cells in ascending order
+        std::vector<int32_t> toIndexes() const;
+
+        // Calls fn( index ) for every set cell in ascending order
+        template <typename Function>
+        void forEach( Function fn ) const
+        {
+            for ( int32_t word = 0; word < 2; ++word ) {
+                uint64_t bits = _word[word];
+                while ( bits ) {
+                    fn( ( word << 6 ) + _lowestBit( bits ) );
+                    bits &= bits - 1;
+                }
+            }
+        }
+
+        Bitboard & operator|=( const Bitboard & other )
+        {
+            _word[0] |= other._word[0];
+            _word[1] |= other._word[1];
+            return *this;
+        }
+
+        Bitboard & operator&=( const Bitboard & other )
+        {
+            _word[0] &= other._word[0];
+            _word[1] &= other._word[1];
+            return *this;
+        }
+
+        Bitboard operator|( const Bitboard & other ) const
+        {
+            Bitboard result( *this );
+            return result |= other;
+        }
+
+        Bitboard operator&( const Bitboard & other ) const
+        {
+            Bitboard result( *this );
+            return result &= other;
+        }
+
+        // Complement within the battlefield, cells outside of the board are never set
+        Bitboard operator~() const;
+
+        bool operator==( const Bitboard & other ) const
+        {
+            return _word[0] == other._word[0] && _word[1] == other._word[1];
+        }
+
+        bool operator!=( const Bitboard & other ) const
+        {
+            return !( *this == other );
+        }
+
+        // Cells adjacent to the given cell, the cell itself is not included
+        static const Bitboard & getAroundMask( const int32_t index );
+
+        // Cells located within the given distance from the given cell, the cell itself is included
+        static const Bitboard & getDistanceMask( const int32_t index, const uint32_t radius );
+
+        // Cell adjacent to the given cell in the given direction (direction_t) or -1 if there is no such cell
+        static int32_t getNeighbour( const int32_t index, const int direction );
+
+        // Direction (direction_t) from the first cell to the second one: CENTER for the same cell, UNKNOWN if cells are not adjacent
+        static int getDirection( const int32_t from, const int32_t to );
+
+        static uint32_t getDistance( const int32_t index1, const int32_t index2 );
+
+    private:
+        static int32_t _lowestBit( const uint64_t bits );
+
+        uint64_t _word[2] = { 0, 0 };
+    };
+}
+
+#endif
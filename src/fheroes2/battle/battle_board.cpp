@@ -24,11 +24,11 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
-#include <iterator>
 #include <set>
 
 #include "battle_arena.h"
 #include "battle_army.h"
+#include "battle_bitboard.h"
 #include "battle_board.h"
 #include "battle_bridge.h"
 #include "battle_troop.h"
@@ -160,21 +160,7 @@ void Battle::Board::SetEnemyQuality( const Unit & unit ) const
 uint32_t Battle::Board::GetDistance( s32 index1, s32 index2 )
 {
     if ( isValidIndex( index1 ) && isValidIndex( index2 ) ) {
-        const int32_t x1 = index1 % ARENAW;
-        const int32_t y1 = index1 / ARENAW;
-
-        const int32_t x2 = index2 % ARENAW;
-        const int32_t y2 = index2 / ARENAW;
-
-        const int32_t du = y2 - y1;
-        const int32_t dv = ( x2 + y2 / 2 ) - ( x1 + y1 / 2 );
-
-        if ( ( du >= 0 && dv >= 0 ) || ( du < 0 && dv < 0 ) ) {
-            return std::max( std::abs( du ), std::abs( dv ) );
-        }
-        else {
-            return std::abs( du ) + std::abs( dv );
-        }
+        return Bitboard::getDistance( index1, index2 );
     }
 
     return 0;
@@ -549,12 +535,7 @@ int32_t Battle::Board::OptimalAttackValue( const Unit & attacker, const Unit & t
 int Battle::Board::GetDirection( s32 index1, s32 index2 )
 {
     if ( isValidIndex( index1 ) && isValidIndex( index2 ) ) {
-        if ( index1 == index2 )
-            return CENTER;
-        else
-            for ( direction_t dir = TOP_LEFT; dir < CENTER; ++dir )
-                if ( isValidDirection( index1, dir ) && index2 == GetIndexDirection( index1, dir ) )
-                    return dir;
+        return Bitboard::getDirection( index1, index2 );
     }
 
     return UNKNOWN;
@@ -562,7 +543,7 @@ int Battle::Board::GetDirection( s32 index1, s32 index2 )
 
 bool Battle::Board::isNearIndexes( s32 index1, s32 index2 )
 {
-    return index1 != index2 && UNKNOWN != GetDirection( index1, index2 );
+    return isValidIndex( index1 ) && isValidIndex( index2 ) && Bitboard::getAroundMask( index1 ).test( index2 );
 }
 
 int Battle::Board::GetReflectDirection( int d )
@@ -626,27 +607,7 @@ int Battle::Board::DistanceFromOriginX( int32_t index, bool reflect )
 bool Battle::Board::isValidDirection( s32 index, int dir )
 {
     if ( isValidIndex( index ) ) {
-        const s32 x = index % ARENAW;
-        const s32 y = index / ARENAW;
-
-        switch ( dir ) {
-        case CENTER:
-            return true;
-        case TOP_LEFT:
-            return !( 0 == y || ( 0 == x && ( y % 2 ) ) );
-        case TOP_RIGHT:
-            return !( 0 == y || ( ( ARENAW - 1 ) == x && !( y % 2 ) ) );
-        case LEFT:
-            return !( 0 == x );
-        case RIGHT:
-            return !( ( ARENAW - 1 ) == x );
-        case BOTTOM_LEFT:
-            return !( ( ARENAH - 1 ) == y || ( 0 == x && ( y % 2 ) ) );
-        case BOTTOM_RIGHT:
-            return !( ( ARENAH - 1 ) == y || ( ( ARENAW - 1 ) == x && !( y % 2 ) ) );
-        default:
-            break;
-        }
+        return CENTER == dir || Bitboard::getNeighbour( index, dir ) >= 0;
     }
 
     return false;
@@ -655,26 +616,7 @@ bool Battle::Board::isValidDirection( s32 index, int dir )
 s32 Battle::Board::GetIndexDirection( s32 index, int dir )
 {
     if ( isValidIndex( index ) ) {
-        const s32 y = index / ARENAW;
-
-        switch ( dir ) {
-        case CENTER:
-            return index;
-        case TOP_LEFT:
-            return index - ( ( y % 2 ) ? ARENAW + 1 : ARENAW );
-        case TOP_RIGHT:
-            return index - ( ( y % 2 ) ? ARENAW : ARENAW - 1 );
-        case LEFT:
-            return index - 1;
-        case RIGHT:
-            return index + 1;
-        case BOTTOM_LEFT:
-            return index + ( ( y % 2 ) ? ARENAW - 1 : ARENAW );
-        case BOTTOM_RIGHT:
-            return index + ( ( y % 2 ) ? ARENAW : ARENAW + 1 );
-        default:
-            break;
-        }
+        return CENTER == dir ? index : Bitboard::getNeighbour( index, dir );
     }
 
     return -1;
@@ -1004,40 +946,35 @@ Battle::Indexes Battle::Board::GetMoveWideIndexes( s32 center, bool reflect )
     if ( isValidIndex( center ) ) {
         result.reserve( 4 );
 
-        if ( reflect ) {
-            if ( isValidDirection( center, LEFT ) )
-                result.push_back( GetIndexDirection( center, LEFT ) );
-            if ( isValidDirection( center, RIGHT ) )
-                result.push_back( GetIndexDirection( center, RIGHT ) );
-            if ( isValidDirection( center, TOP_LEFT ) )
-                result.push_back( GetIndexDirection( center, TOP_LEFT ) );
-            if ( isValidDirection( center, BOTTOM_LEFT ) )
-                result.push_back( GetIndexDirection( center, BOTTOM_LEFT ) );
-        }
-        else {
-            if ( isValidDirection( center, LEFT ) )
-                result.push_back( GetIndexDirection( center, LEFT ) );
-            if ( isValidDirection( center, RIGHT ) )
-                result.push_back( GetIndexDirection( center, RIGHT ) );
-            if ( isValidDirection( center, TOP_RIGHT ) )
-                result.push_back( GetIndexDirection( center, TOP_RIGHT ) );
-            if ( isValidDirection( center, BOTTOM_RIGHT ) )
-                result.push_back( GetIndexDirection( center, BOTTOM_RIGHT ) );
+        for ( const int direction : GetMoveWideDirections( reflect ) ) {
+            const int32_t index = Bitboard::getNeighbour( center, direction );
+            if ( index >= 0 )
+                result.push_back( index );
         }
     }
     return result;
 }
 
+const std::array<int, 4> & Battle::Board::GetMoveWideDirections( const bool reflect )
+{
+    static const std::array<int, 4> reflectDirections = { { LEFT, RIGHT, TOP_LEFT, BOTTOM_LEFT } };
+    static const std::array<int, 4> directions = { { LEFT, RIGHT, TOP_RIGHT, BOTTOM_RIGHT } };
+
+    return reflect ? reflectDirections : directions;
+}
+
 Battle::Indexes Battle::Board::GetAroundIndexes( s32 center, s32 ignore )
 {
     Indexes result;
 
     if ( isValidIndex( center ) ) {
-        result.reserve( 12 );
+        result.reserve( 6 );
 
-        for ( direction_t dir = TOP_LEFT; dir < CENTER; ++dir )
-            if ( isValidDirection( center, dir ) && GetIndexDirection( center, dir ) != ignore )
-                result.push_back( GetIndexDirection( center, dir ) );
+        for ( direction_t dir = TOP_LEFT; dir < CENTER; ++dir ) {
+            const int32_t index = Bitboard::getNeighbour( center, dir );
+            if ( index >= 0 && index != ignore )
+                result.push_back( index );
+        }
     }
 
     return result;
@@ -1049,60 +986,40 @@ Battle::Indexes Battle::Board::GetAroundIndexes( const Unit & b )
 }
 
 Battle::Indexes Battle::Board::GetAroundIndexes( const Position & position )
+{
+    if ( position.GetTail() ) {
+        return GetAroundMask( position ).toIndexes();
+    }
+
+    return GetAroundIndexes( position.GetHead()->GetIndex() );
+}
+
+Battle::Bitboard Battle::Board::GetAroundMask( const Position & position )
 {
     const int headIdx = position.GetHead()->GetIndex();
+    Bitboard around = Bitboard::getAroundMask( headIdx );
 
     if ( position.GetTail() ) {
         const int tailIdx = position.GetTail()->GetIndex();
 
-        Indexes around = GetAroundIndexes( headIdx, tailIdx );
-        const Indexes & tail = GetAroundIndexes( tailIdx, headIdx );
-        around.insert( around.end(), tail.begin(), tail.end() );
-
-        std::sort( around.begin(), around.end() );
-        around.erase( std::unique( around.begin(), around.end() ), around.end() );
-
-        return around;
+        around |= Bitboard::getAroundMask( tailIdx );
+        around.reset( headIdx );
+        around.reset( tailIdx );
     }
 
-    return GetAroundIndexes( headIdx );
+    return around;
 }
 
 Battle::Indexes Battle::Board::GetDistanceIndexes( s32 center, u32 radius )
 {
-    Indexes result;
-
-    if ( isValidIndex( center ) ) {
-        std::set<s32> st;
-        Indexes abroad;
-
-        st.insert( center );
-        abroad.push_back( center );
-
-        while ( !abroad.empty() && radius ) {
-            std::set<s32> tm = st;
-
-            for ( Indexes::const_iterator it = abroad.begin(); it != abroad.end(); ++it ) {
-                const Indexes around = GetAroundIndexes( *it );
-                tm.insert( around.begin(), around.end() );
-            }
-
-            abroad.resize( tm.size() );
-
-            Indexes::iterator abroad_end = std::set_difference( tm.begin(), tm.end(), st.begin(), st.end(), abroad.begin() );
-
-            abroad.resize( std::distance( abroad.begin(), abroad_end ) );
-
-            st.swap( tm );
-            --radius;
-        }
-
-        st.erase( center );
-        result.reserve( st.size() );
-        std::copy( st.begin(), st.end(), std::back_inserter( result ) );
+    if ( !isValidIndex( center ) ) {
+        return {};
     }
 
-    return result;
+    Bitboard area = Bitboard::getDistanceMask( center, radius );
+    area.reset( center );
+
+    return area.toIndexes();
 }
 
 bool Battle::Board::isValidMirrorImageIndex( s32 index, const Unit * troop )
@@ -1252,6 +1169,19 @@ Battle::Indexes Battle::Board::GetAdjacentEnemies( const Unit & unit )
     return result;
 }
 
+Battle::Bitboard Battle::Board::GetOccupiedMask() const
+{
+    Bitboard occupied;
+
+    for ( const Cell & cell : *this ) {
+        if ( cell.GetUnit() != nullptr ) {
+            occupied.set( cell.GetIndex() );
+        }
+    }
+
+    return occupied;
+}
+
 int32_t Battle::Board::FixupDestinationCell( const Unit & currentUnit, const int32_t dst )
 {
     // Only wide units may need this fixup
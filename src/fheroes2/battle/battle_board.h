@@ -23,8 +23,10 @@
 #ifndef H2BATTLE_BOARD_H
 #define H2BATTLE_BOARD_H
 
+#include <array>
 #include <random>
 
+#include "battle_bitboard.h"
 #include "battle_cell.h"
 
 #define ARENAW 11
@@ -94,7 +96,10 @@ namespace Battle
         static Indexes GetAroundIndexes( s32 center, s32 ignore = -1 );
         static Indexes GetAroundIndexes( const Unit & unit );
         static Indexes GetAroundIndexes( const Position & position );
+        static Bitboard GetAroundMask( const Position & position );
         static Indexes GetMoveWideIndexes( s32, bool reflect );
+        // Directions in which a wide unit can move its head, in the order used by GetMoveWideIndexes()
+        static const std::array<int, 4> & GetMoveWideDirections( const bool reflect );
         static bool isValidMirrorImageIndex( s32, const Unit * );
 
         // Checks that the current unit (to which the current passability information relates) is able (in principle)
@@ -106,6 +111,9 @@ namespace Battle
 
         static Indexes GetAdjacentEnemies( const Unit & unit );
 
+        // Cells occupied by units
+        Bitboard GetOccupiedMask() const;
+
         // Handles the situation when the cell with the given index is specified as the target cell for the movement of
         // the current unit (to which the current passability information relates), this cell is located on the border
         // of the cell space reachable for this unit and it should be the tail cell of this unit
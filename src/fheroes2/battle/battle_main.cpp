@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <memory>
 
+#include "agg_image.h"
 #include "ai.h"
 #include "army.h"
 #include "artifact.h"
@@ -31,6 +32,7 @@
 #include "dialog.h"
 #include "game.h"
 #include "heroes_base.h"
+#include "icn.h"
 #include "kingdom.h"
 #include "logging.h"
 #include "settings.h"
@@ -138,6 +140,24 @@ namespace
         return seed;
     }
 
+    // Decode all images of both armies in advance to avoid delays during the first turns of the battle.
+    void prefetchBattleImages( const Army & army1, const Army & army2 )
+    {
+        std::vector<int> icnIds{ ICN::TEXTBAR, ICN::CMSECO, ICN::EXPMRL, ICN::MONS32, ICN::SPELLS };
+
+        for ( const Army * army : { &army1, &army2 } ) {
+            for ( size_t i = 0; i < army->Size(); ++i ) {
+                const Troop * troop = army->GetTroop( i );
+                if ( troop->isValid() ) {
+                    icnIds.push_back( troop->GetMonsterSprite() );
+                    icnIds.push_back( static_cast<int>( Monster::GetMissileICN( troop->GetID() ) ) );
+                }
+            }
+        }
+
+        fheroes2::AGG::PrefetchICN( icnIds );
+    }
+
     uint32_t getBattleResult( const uint32_t army )
     {
         if ( army & Battle::RESULT_SURRENDER )
@@ -207,6 +227,10 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, s32 mapsindex )
         showBattle = true;
 #endif
 
+    if ( showBattle ) {
+        prefetchBattleImages( army1, army2 );
+    }
+
     const size_t battleSeed = Settings::Get().ExtBattleDeterministicResult() ? computeBattleSeed( mapsindex, world.GetMapSeed(), army1, army2 )
                                                                              : Rand::Get( std::numeric_limits<uint32_t>::max() );
 
@@ -256,10 +280,12 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, s32 mapsindex )
         if ( loserHero != nullptr && loserAbandoned ) {
             // if a hero lost the battle and didn't flee or surrender, they lose all artifacts
             clearArtifacts( loserHero->GetBagArtifacts() );
+            loserHero->invalidateStats();
 
             // if the other army also had a hero, some artifacts may be captured by them
             if ( winnerHero != nullptr ) {
                 transferArtifacts( winnerHero->GetBagArtifacts(), artifactsToTransfer );
+                winnerHero->invalidateStats();
             }
         }
 
@@ -322,6 +348,11 @@ Battle::Result Battle::Loader( Army & army1, Army & army2, s32 mapsindex )
 
     DEBUG_LOG( DBG_BATTLE, DBG_INFO, "army1: " << ( result.army1 & RESULT_WINS ? "wins" : "loss" ) << ", army2: " << ( result.army2 & RESULT_WINS ? "wins" : "loss" ) );
 
+    if ( showBattle ) {
+        // The battle arena and its interface are destroyed so images of both armies are not in use anymore.
+        fheroes2::AGG::ReleaseUnusedImages();
+    }
+
     return result;
 }
 
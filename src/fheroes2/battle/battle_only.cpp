@@ -367,6 +367,12 @@ bool Battle::Only::ChangeSettings( void )
             continue;
         }
 
+        // skills and artifacts of the heroes are edited in place above
+        if ( hero1 )
+            hero1->invalidateStats();
+        if ( hero2 )
+            hero2->invalidateStats();
+
         RedrawBaseInfo( cur_pt );
         moraleIndicator1->Redraw();
         luckIndicator1->Redraw();
@@ -25,6 +25,7 @@
 #include "castle.h"
 #include "logging.h"
 #include <algorithm>
+#include <array>
 
 namespace Battle
 {
@@ -45,6 +46,7 @@ namespace Battle
     void ArenaPathfinder::reset()
     {
         _start.Set( -1, false, false );
+        _passableCells = Bitboard();
         for ( size_t i = 0; i < _cache.size(); ++i ) {
             _cache[i].resetNode();
         }
@@ -52,8 +54,7 @@ namespace Battle
 
     bool ArenaPathfinder::hexIsPassable( int targetCell ) const
     {
-        const size_t index = static_cast<size_t>( targetCell );
-        return index < _cache.size() && nodeIsPassable( _cache[index] );
+        return Board::isValidIndex( targetCell ) && _passableCells.test( targetCell );
     }
 
     bool ArenaPathfinder::nodeIsPassable( const ArenaNode & node ) const
@@ -61,18 +62,21 @@ namespace Battle
         return node._cost == 0 || ( node._isOpen && node._from != -1 );
     }
 
-    Indexes ArenaPathfinder::getAllAvailableMoves( uint32_t moveRange ) const
+    Bitboard ArenaPathfinder::getReachableCells( uint32_t moveRange ) const
     {
-        Indexes result;
-        result.reserve( moveRange * 2u );
+        Bitboard reachable;
 
-        for ( size_t index = 0; index < _cache.size(); ++index ) {
-            const ArenaNode & node = _cache[index];
-            if ( nodeIsPassable( node ) && node._cost <= moveRange ) {
-                result.push_back( static_cast<int>( index ) );
+        _passableCells.forEach( [this, moveRange, &reachable]( const int32_t index ) {
+            if ( _cache[index]._cost <= moveRange ) {
+                reachable.set( index );
             }
-        }
-        return result;
+        } );
+        return reachable;
+    }
+
+    Indexes ArenaPathfinder::getAllAvailableMoves( uint32_t moveRange ) const
+    {
+        return getReachableCells( moveRange ).toIndexes();
     }
 
     Indexes ArenaPathfinder::buildPath( int targetCell ) const
@@ -159,9 +163,10 @@ namespace Battle
             _cache[tailIdx]._isLeftDirection = !unit.isReflect();
         }
 
-        if ( unit.isFlying() ) {
-            const Board & board = *Arena::GetBoard();
+        const Board & board = *Arena::GetBoard();
+        const Bitboard occupiedCells = board.GetOccupiedMask();
 
+        if ( unit.isFlying() ) {
             // Find all free spaces on the battle board - flyers can move to any of them
             for ( Board::const_iterator it = board.begin(); it != board.end(); ++it ) {
                 const int32_t idx = it->GetIndex();
@@ -177,24 +182,33 @@ namespace Battle
                     node._isOpen = false;
                 }
             }
+            // Passable cells are known now, they are needed to find the shortest flight path to units
+            for ( size_t index = 0; index < _cache.size(); ++index ) {
+                if ( nodeIsPassable( _cache[index] ) ) {
+                    _passableCells.set( static_cast<int32_t>( index ) );
+                }
+            }
+
             // Once board movement is determined we look for units save shortest flight path to them
-            for ( Board::const_iterator it = board.begin(); it != board.end(); ++it ) {
-                const Unit * boardUnit = it->GetUnit();
-                if ( boardUnit && boardUnit->GetUID() != unit.GetUID() ) {
-                    const int32_t unitIdx = it->GetIndex();
-                    ArenaNode & unitNode = _cache[unitIdx];
-
-                    const Indexes & around = Battle::Board::GetAroundIndexes( unitIdx );
-                    for ( const int32_t cell : around ) {
-                        const uint32_t flyingDist = Battle::Board::GetDistance( pathStart, cell );
-                        if ( hexIsPassable( cell ) && ( flyingDist < unitNode._cost ) ) {
-                            unitNode._isOpen = false;
-                            unitNode._from = cell;
-                            unitNode._cost = flyingDist;
-                        }
+            occupiedCells.forEach( [this, &board, &unit, pathStart]( const int32_t unitIdx ) {
+                if ( board[unitIdx].GetUnit()->GetUID() == unit.GetUID() )
+                    return;
+
+                ArenaNode & unitNode = _cache[unitIdx];
+
+                for ( direction_t dir = TOP_LEFT; dir < CENTER; ++dir ) {
+                    const int32_t cell = Bitboard::getNeighbour( unitIdx, dir );
+                    if ( cell < 0 )
+                        continue;
+
+                    const uint32_t flyingDist = Bitboard::getDistance( pathStart, cell );
+                    if ( _passableCells.test( cell ) && ( flyingDist < unitNode._cost ) ) {
+                        unitNode._isOpen = false;
+                        unitNode._from = cell;
+                        unitNode._cost = flyingDist;
                     }
                 }
-            }
+            } );
         }
         else {
             // Walkers - explore moves sequentially from both head and tail cells
@@ -207,15 +221,28 @@ namespace Battle
                 const int32_t fromNode = nodesToExplore[lastProcessedNode];
                 const ArenaNode & previousNode = _cache[fromNode];
 
-                Indexes availableMoves;
-                if ( !unitIsWide )
-                    availableMoves = Board::GetAroundIndexes( fromNode );
-                else if ( previousNode._from < 0 )
-                    availableMoves = Board::GetMoveWideIndexes( fromNode, unit.isReflect() );
-                else
-                    availableMoves = Board::GetMoveWideIndexes( fromNode, ( RIGHT_SIDE & Board::GetDirection( fromNode, previousNode._from ) ) != 0 );
+                // Neighbour cells are taken from precomputed tables in the same order as Board::GetAroundIndexes() and Board::GetMoveWideIndexes() return them
+                std::array<int32_t, 6> availableMoves;
+                size_t moveCount = 0;
+
+                if ( !unitIsWide ) {
+                    for ( direction_t dir = TOP_LEFT; dir < CENTER; ++dir ) {
+                        const int32_t index = Bitboard::getNeighbour( fromNode, dir );
+                        if ( index >= 0 )
+                            availableMoves[moveCount++] = index;
+                    }
+                }
+                else {
+                    const bool reflect = ( previousNode._from < 0 ) ? unit.isReflect() : ( RIGHT_SIDE & Board::GetDirection( fromNode, previousNode._from ) ) != 0;
+                    for ( const int direction : Board::GetMoveWideDirections( reflect ) ) {
+                        const int32_t index = Bitboard::getNeighbour( fromNode, direction );
+                        if ( index >= 0 )
+                            availableMoves[moveCount++] = index;
+                    }
+                }
 
-                for ( const int32_t newNode : availableMoves ) {
+                for ( size_t moveId = 0; moveId < moveCount; ++moveId ) {
+                    const int32_t newNode = availableMoves[moveId];
                     const Cell * headCell = Board::GetCell( newNode );
                     const bool isLeftDirection = unitIsWide && Board::IsLeftDirection( fromNode, newNode, previousNode._isLeftDirection );
 
@@ -240,7 +267,7 @@ namespace Battle
                         }
 
                         // Now we check if headCell has a unit - this determines if hex is passable or just accessible (for attack)
-                        if ( headCell->GetUnit() && cost < node._cost ) {
+                        if ( occupiedCells.test( newNode ) && cost < node._cost ) {
                             node._isOpen = false;
                             node._from = fromNode;
                             node._cost = cost;
@@ -257,5 +284,12 @@ namespace Battle
                 }
             }
         }
+
+        _passableCells = Bitboard();
+        for ( size_t index = 0; index < _cache.size(); ++index ) {
+            if ( nodeIsPassable( _cache[index] ) ) {
+                _passableCells.set( static_cast<int32_t>( index ) );
+            }
+        }
     }
 }
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "battle_bitboard.h"
 #include "battle_board.h"
 #include "pathfinding.h"
 
@@ -62,11 +63,14 @@ namespace Battle
         Indexes buildPath( int targetCell ) const;
         Indexes findTwoMovesOverlap( int targetCell, uint32_t movementRange ) const;
         bool hexIsPassable( int targetCell ) const;
+        // Cells where the unit can stop within the given movement range
+        Bitboard getReachableCells( uint32_t moveRange ) const;
         Indexes getAllAvailableMoves( uint32_t moveRange ) const;
 
     private:
         bool nodeIsPassable( const ArenaNode & node ) const;
 
         Position _start;
+        Bitboard _passableCells;
     };
 }
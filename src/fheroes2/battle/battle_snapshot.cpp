@@ -0,0 +1,606 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_snapshot.h"
+#include "battle_troop.h"
+#include "castle.h"
+#include "game_static.h"
+#include "heroes_base.h"
+#include "rand.h"
+#include "spell.h"
+
+namespace
+{
+    const int32_t moatCells[] = { 7, 18, 28, 39, 61, 72, 84, 95 };
+    const int32_t bridgeMoatCell = 49;
+
+    uint32_t getCountFromHitPoints( const uint32_t hitPoints, const uint32_t monsterHitPoints )
+    {
+        return ( hitPoints + monsterHitPoints - 1 ) / monsterHitPoints;
+    }
+
+    uint32_t getUnitModes( const Battle::Unit & unit )
+    {
+        uint32_t modes = 0;
+
+        for ( uint32_t bit = 0; bit < 32; ++bit ) {
+            const uint32_t mode = 1u << bit;
+            if ( unit.Modes( mode ) ) {
+                modes |= mode;
+            }
+        }
+
+        return modes;
+    }
+
+    Battle::Snapshot::UnitState getTroopState( const Troop & troop, const HeroBase * commander )
+    {
+        using Snapshot = Battle::Snapshot;
+
+        Snapshot::UnitState state;
+        state.monsterId = troop.GetID();
+
+        state.count = troop.GetCount();
+        state.initialCount = troop.GetCount();
+        state.hitPoints = troop.GetHitPoints();
+        state.monsterHitPoints = troop.Monster::GetHitPoints();
+
+        state.attack = troop.GetAttack();
+        state.defense = troop.GetDefense();
+        state.damageMin = troop.Monster::GetDamageMin();
+        state.damageMax = troop.Monster::GetDamageMax();
+        state.speed = troop.GetSpeed();
+        state.shots = troop.GetShots();
+        state.luck = troop.GetLuck();
+        state.durations.fill( 0 );
+        state.strength = troop.GetMonsterStrength();
+
+        if ( troop.isWide() )
+            state.flags |= Snapshot::UNIT_WIDE;
+        if ( troop.isFlying() )
+            state.flags |= Snapshot::UNIT_FLYING;
+        if ( troop.isArchers() )
+            state.flags |= Snapshot::UNIT_ARCHER;
+        if ( troop.isTwiceAttack() )
+            state.flags |= Snapshot::UNIT_TWICE_ATTACK;
+        if ( troop.isAbilityPresent( fheroes2::MonsterAbilityType::ALWAYS_RETALIATE ) )
+            state.flags |= Snapshot::UNIT_ALWAYS_RETALIATE;
+        if ( troop.ignoreRetaliation() )
+            state.flags |= Snapshot::UNIT_IGNORE_RETALIATION;
+        if ( troop.isAbilityPresent( fheroes2::MonsterAbilityType::NO_MELEE_PENALTY ) )
+            state.flags |= Snapshot::UNIT_NO_MELEE_PENALTY;
+        if ( troop.isRegenerating() )
+            state.flags |= Snapshot::UNIT_REGENERATING;
+
+        if ( commander ) {
+            state.archeryBonus = commander->GetSecondaryValues( Skill::Secondary::ARCHERY );
+
+            if ( commander->hasArtifact( Artifact::AMMO_CART ) )
+                state.flags |= Snapshot::UNIT_UNLIMITED_SHOTS;
+            if ( commander->hasArtifact( Artifact::GOLDEN_BOW ) || commander->GetLevelSkill( Skill::Secondary::ARCHERY ) != Skill::Level::NONE )
+                state.flags |= Snapshot::UNIT_NO_SHOOTING_PENALTY;
+        }
+
+        return state;
+    }
+
+    void resetMode( Battle::Snapshot::UnitState & unit, const uint32_t mode )
+    {
+        unit.modes &= ~mode;
+
+        for ( uint32_t bit = 0; bit < 32; ++bit ) {
+            if ( mode & ( 1u << bit ) ) {
+                unit.durations[bit] = 0;
+            }
+        }
+    }
+}
+
+Battle::Snapshot::Snapshot( Arena & arena )
+{
+    _cellUnits.fill( -1 );
+
+    const Board & board = *Arena::GetBoard();
+    for ( const Cell & cell : board ) {
+        if ( !cell.isPassable1( false ) ) {
+            _obstacleCells.set( cell.GetIndex() );
+        }
+    }
+
+    const Castle * castle = Arena::GetCastle();
+    _hasCastle = castle != nullptr;
+
+    if ( castle ) {
+        if ( castle->isBuild( BUILD_MOAT ) ) {
+            _moatDefensePenalty = GameStatic::GetBattleMoatReduceDefense();
+        }
+
+        _areWallsIntact = board[Arena::CASTLE_FIRST_TOP_WALL_POS].GetObject() != 0 && board[Arena::CASTLE_SECOND_TOP_WALL_POS].GetObject() != 0
+                          && board[Arena::CASTLE_THIRD_TOP_WALL_POS].GetObject() != 0 && board[Arena::CASTLE_FOURTH_TOP_WALL_POS].GetObject() != 0;
+    }
+
+    int side = 0;
+    for ( const Force * force : { &arena.GetForce1(), &arena.GetForce2() } ) {
+        for ( const Unit * unit : *force ) {
+            if ( unit == nullptr || !unit->isValid() ) {
+                continue;
+            }
+
+            UnitState state = getTroopState( *unit, unit->GetCommander() );
+            state.uid = unit->GetUID();
+            state.side = side;
+            state.modes = getUnitModes( *unit );
+
+            state.initialCount = unit->GetInitialCount();
+            state.hitPoints = unit->GetHitPoints();
+            state.speed = unit->GetSpeed( true, true );
+            state.shots = unit->GetShots();
+
+            state.headIndex = unit->GetHeadIndex();
+            state.tailIndex = unit->isWide() ? unit->GetTailIndex() : -1;
+
+            for ( uint32_t bit = 0; bit < 32; ++bit ) {
+                if ( state.modes & ( 1u << bit ) ) {
+                    state.durations[bit] = static_cast<uint8_t>( std::min( unit->GetAffectedDuration( 1u << bit ), 255u ) );
+                }
+            }
+
+            // Unit overrides some of the monster properties depending on the battle state
+            state.flags &= ~( UNIT_FLYING | UNIT_ARCHER );
+            if ( unit->isFlying() )
+                state.flags |= UNIT_FLYING;
+            if ( unit->isArchers() )
+                state.flags |= UNIT_ARCHER;
+            if ( Board::isMoatIndex( bridgeMoatCell, *unit ) )
+                state.flags |= UNIT_BRIDGE_IS_MOAT;
+
+            _addUnit( state );
+
+            // Defense is stored without the moat penalty, it is applied again depending on the current position
+            const int32_t unitId = static_cast<int32_t>( _units.size() - 1 );
+            if ( _moatDefensePenalty > 0 && getDefense( unitId ) != state.defense ) {
+                _units[unitId].defense += _moatDefensePenalty;
+            }
+        }
+
+        ++side;
+    }
+}
+
+void Battle::Snapshot::_addUnit( const UnitState & state )
+{
+    assert( _units.size() < 127 );
+
+    _units.push_back( state );
+    _placeUnit( static_cast<int32_t>( _units.size() - 1 ) );
+}
+
+int32_t Battle::Snapshot::findUnit( const uint32_t uid ) const
+{
+    for ( size_t i = 0; i < _units.size(); ++i ) {
+        if ( _units[i].uid == uid ) {
+            return static_cast<int32_t>( i );
+        }
+    }
+
+    return -1;
+}
+
+Battle::Bitboard Battle::Snapshot::getUnitCells( const int32_t unitId ) const
+{
+    const UnitState & unit = _units[unitId];
+
+    Bitboard cells;
+    if ( unit.isValid() ) {
+        cells.set( unit.headIndex );
+        if ( unit.tailIndex >= 0 ) {
+            cells.set( unit.tailIndex );
+        }
+    }
+
+    return cells;
+}
+
+Battle::Bitboard Battle::Snapshot::getSideCells( const int side ) const
+{
+    Bitboard cells;
+
+    for ( size_t i = 0; i < _units.size(); ++i ) {
+        if ( _units[i].side == side ) {
+            cells |= getUnitCells( static_cast<int32_t>( i ) );
+        }
+    }
+
+    return cells;
+}
+
+bool Battle::Snapshot::isHandFighting( const int32_t unitId ) const
+{
+    const UnitState & unit = _units[unitId];
+    if ( !unit.isValid() || unit.isModes( CAP_TOWER ) ) {
+        return false;
+    }
+
+    Bitboard around = Bitboard::getAroundMask( unit.headIndex );
+    if ( unit.tailIndex >= 0 ) {
+        around |= Bitboard::getAroundMask( unit.tailIndex );
+    }
+
+    bool isEnemyAround = false;
+    ( around & _occupiedCells ).forEach( [this, &unit, &isEnemyAround]( const int32_t index ) {
+        if ( _units[_cellUnits[index]].side != unit.side ) {
+            isEnemyAround = true;
+        }
+    } );
+
+    return isEnemyAround;
+}
+
+bool Battle::Snapshot::isHandFighting( const int32_t attackerId, const int32_t defenderId ) const
+{
+    const UnitState & attacker = _units[attackerId];
+    const UnitState & defender = _units[defenderId];
+
+    if ( !attacker.isValid() || !defender.isValid() || attacker.isModes( CAP_TOWER ) || attacker.side == defender.side ) {
+        return false;
+    }
+
+    Bitboard around = Bitboard::getAroundMask( attacker.headIndex );
+    if ( attacker.tailIndex >= 0 ) {
+        around |= Bitboard::getAroundMask( attacker.tailIndex );
+    }
+
+    return !( around & getUnitCells( defenderId ) ).empty();
+}
+
+uint32_t Battle::Snapshot::getDefense( const int32_t unitId ) const
+{
+    const UnitState & unit = _units[unitId];
+    uint32_t defense = unit.defense;
+
+    if ( _moatDefensePenalty > 0 ) {
+        bool isInMoat = false;
+        for ( const int32_t index : { unit.headIndex, unit.tailIndex } ) {
+            if ( index < 0 ) {
+                continue;
+            }
+            if ( std::find( std::begin( moatCells ), std::end( moatCells ), index ) != std::end( moatCells )
+                 || ( index == bridgeMoatCell && unit.hasFlag( UNIT_BRIDGE_IS_MOAT ) ) ) {
+                isInMoat = true;
+            }
+        }
+
+        if ( isInMoat ) {
+            defense = _moatDefensePenalty >= defense ? 1 : defense - _moatDefensePenalty;
+        }
+    }
+
+    return defense;
+}
+
+bool Battle::Snapshot::_isShootingPenalty( const UnitState & attacker, const UnitState & defender ) const
+{
+    // Broken walls are not tracked by the line of fire, the penalty is assumed to be lifted by any breach
+    if ( !_hasCastle || !_areWallsIntact ) {
+        return false;
+    }
+
+    if ( defender.isModes( CAP_TOWER ) || attacker.isModes( CAP_TOWER ) || attacker.hasFlag( UNIT_NO_SHOOTING_PENALTY ) ) {
+        return false;
+    }
+
+    const auto isOutOfWalls = []( const UnitState & unit ) {
+        return Board::isOutOfWallsIndex( unit.headIndex ) || ( unit.tailIndex >= 0 && Board::isOutOfWallsIndex( unit.tailIndex ) );
+    };
+
+    return isOutOfWalls( attacker ) && !isOutOfWalls( defender );
+}
+
+uint32_t Battle::Snapshot::calculateDamage( const int32_t attackerId, const int32_t defenderId, double dmg ) const
+{
+    const UnitState & attacker = _units[attackerId];
+    const UnitState & defender = _units[defenderId];
+
+    if ( attacker.hasFlag( UNIT_ARCHER ) ) {
+        if ( !isHandFighting( attackerId ) ) {
+            dmg += ( dmg * attacker.archeryBonus / 100 );
+
+            if ( _isShootingPenalty( attacker, defender ) )
+                dmg /= 2;
+
+            if ( defender.isModes( SP_SHIELD ) )
+                dmg /= Spell( Spell::SHIELD ).ExtraValue();
+        }
+        else if ( !attacker.hasFlag( UNIT_NO_MELEE_PENALTY ) ) {
+            dmg /= 2;
+        }
+    }
+
+    if ( attacker.hasFlag( UNIT_BLIND_ANSWER ) )
+        dmg /= 2;
+
+    if ( defender.isModes( SP_STONE ) )
+        dmg /= 2;
+
+    return ApplyDamageModifiers( Monster( attacker.monsterId ), Monster( defender.monsterId ), static_cast<int>( attacker.attack ),
+                                 static_cast<int>( getDefense( defenderId ) ), attacker.isModes( SP_DRAGONSLAYER ), dmg );
+}
+
+uint32_t Battle::Snapshot::getDamage( const int32_t attackerId, const int32_t defenderId, std::mt19937 * gen ) const
+{
+    const UnitState & attacker = _units[attackerId];
+
+    const uint32_t minDamage = calculateDamage( attackerId, defenderId, attacker.damageMin * attacker.count );
+    const uint32_t maxDamage = calculateDamage( attackerId, defenderId, attacker.damageMax * attacker.count );
+
+    uint32_t damage = 0;
+    if ( attacker.isModes( SP_BLESS ) )
+        damage = maxDamage;
+    else if ( attacker.isModes( SP_CURSE ) )
+        damage = minDamage;
+    else if ( gen )
+        damage = Rand::GetWithGen( minDamage, maxDamage, *gen );
+    else
+        damage = ( minDamage + maxDamage ) / 2;
+
+    bool isGoodLuck = attacker.isModes( LUCK_GOOD );
+    bool isBadLuck = attacker.isModes( LUCK_BAD );
+
+    if ( gen && !isGoodLuck && !isBadLuck && attacker.luck != 0 ) {
+        const int32_t chance = static_cast<int32_t>( Rand::GetWithGen( 1, 24, *gen ) );
+        isGoodLuck = attacker.luck > 0 && chance <= attacker.luck;
+        isBadLuck = attacker.luck < 0 && chance <= -attacker.luck;
+    }
+
+    if ( isGoodLuck )
+        damage <<= 1;
+    else if ( isBadLuck )
+        damage >>= 1;
+
+    return damage;
+}
+
+uint32_t Battle::Snapshot::applyDamage( const int32_t attackerId, const int32_t defenderId, uint32_t dmg )
+{
+    UnitState & defender = _units[defenderId];
+
+    if ( dmg == 0 || !defender.isValid() ) {
+        return 0;
+    }
+
+    uint32_t killed = dmg >= defender.hitPoints ? defender.count : defender.count - getCountFromHitPoints( defender.hitPoints - dmg, defender.monsterHitPoints );
+
+    // mirror image dies if recieves any damage
+    if ( defender.isModes( CAP_MIRRORIMAGE ) ) {
+        dmg = defender.hitPoints;
+        killed = defender.count;
+    }
+
+    if ( defender.isModes( IS_PARALYZE_MAGIC ) ) {
+        defender.modes |= TR_RESPONSED | TR_MOVED;
+        resetMode( defender, IS_PARALYZE_MAGIC );
+    }
+
+    if ( defender.isModes( SP_BLIND ) ) {
+        defender.modes |= TR_MOVED;
+        resetMode( defender, SP_BLIND );
+    }
+
+    defender.count = killed >= defender.count ? 0 : defender.count - killed;
+    defender.hitPoints -= std::min( dmg, defender.hitPoints );
+
+    if ( !defender.isValid() ) {
+        _removeUnit( defenderId );
+    }
+
+    UnitState & attacker = _units[attackerId];
+
+    if ( killed > 0 && attacker.isValid() ) {
+        if ( attacker.monsterId == Monster::GHOST ) {
+            // grow troop
+            attacker.hitPoints += killed * defender.monsterHitPoints;
+            attacker.count = getCountFromHitPoints( attacker.hitPoints, attacker.monsterHitPoints );
+            attacker.initialCount = std::max( attacker.initialCount, attacker.count );
+        }
+        else if ( attacker.monsterId == Monster::VAMPIRE_LORD ) {
+            // restore hit points
+            attacker.hitPoints += killed * attacker.monsterHitPoints;
+            attacker.count = getCountFromHitPoints( attacker.hitPoints, attacker.monsterHitPoints );
+            if ( attacker.count > attacker.initialCount ) {
+                attacker.count = attacker.initialCount;
+                attacker.hitPoints = attacker.count * attacker.monsterHitPoints;
+            }
+        }
+    }
+
+    return killed;
+}
+
+void Battle::Snapshot::_strike( const int32_t attackerId, const int32_t defenderId, std::mt19937 * gen )
+{
+    applyDamage( attackerId, defenderId, getDamage( attackerId, defenderId, gen ) );
+
+    UnitState & attacker = _units[attackerId];
+
+    if ( attacker.hasFlag( UNIT_ARCHER ) && !attacker.hasFlag( UNIT_UNLIMITED_SHOTS ) && !isHandFighting( attackerId ) && attacker.shots > 0 ) {
+        --attacker.shots;
+    }
+
+    resetMode( attacker, SP_BERSERKER | SP_HYPNOTIZE );
+    attacker.modes &= ~( LUCK_GOOD | LUCK_BAD );
+}
+
+void Battle::Snapshot::attack( const int32_t attackerId, const int32_t defenderId, std::mt19937 * gen )
+{
+    if ( !_units[attackerId].isValid() || !_units[defenderId].isValid() || _units[attackerId].side == _units[defenderId].side ) {
+        return;
+    }
+
+    const bool handFighting = isHandFighting( attackerId, defenderId );
+    if ( !handFighting && !_units[attackerId].hasFlag( UNIT_ARCHER ) ) {
+        return;
+    }
+
+    const auto allowResponse = []( const UnitState & unit ) {
+        return ( !unit.isModes( SP_BLIND ) || unit.hasFlag( UNIT_BLIND_ANSWER ) ) && !unit.isModes( IS_PARALYZE_MAGIC ) && !unit.isModes( SP_HYPNOTIZE )
+               && ( unit.hasFlag( UNIT_ALWAYS_RETALIATE ) || !unit.isModes( TR_RESPONSED ) );
+    };
+
+    if ( _units[defenderId].isModes( SP_BLIND ) ) {
+        _units[defenderId].flags |= UNIT_BLIND_ANSWER;
+    }
+
+    _strike( attackerId, defenderId, gen );
+
+    if ( _units[defenderId].isValid() ) {
+        if ( handFighting && !_units[attackerId].hasFlag( UNIT_IGNORE_RETALIATION ) && allowResponse( _units[defenderId] ) ) {
+            _strike( defenderId, attackerId, gen );
+            _units[defenderId].modes |= TR_RESPONSED;
+        }
+        _units[defenderId].flags &= ~UNIT_BLIND_ANSWER;
+
+        const UnitState & attacker = _units[attackerId];
+
+        // Elves shoot twice only from a distance, see Unit::isTwiceAttack()
+        bool isTwiceAttack = attacker.hasFlag( UNIT_TWICE_ATTACK );
+        if ( attacker.monsterId == Monster::ELF || attacker.monsterId == Monster::GRAND_ELF || attacker.monsterId == Monster::RANGER ) {
+            isTwiceAttack = !isHandFighting( attackerId );
+        }
+
+        if ( attacker.isValid() && isTwiceAttack && !attacker.isModes( SP_BLIND | IS_PARALYZE_MAGIC ) ) {
+            _strike( attackerId, defenderId, gen );
+        }
+    }
+
+    _units[defenderId].flags &= ~UNIT_BLIND_ANSWER;
+}
+
+bool Battle::Snapshot::move( const int32_t unitId, const int32_t headIndex, const int32_t tailIndex )
+{
+    UnitState & unit = _units[unitId];
+    if ( !unit.isValid() || !Board::isValidIndex( headIndex ) || ( unit.hasFlag( UNIT_WIDE ) && !Board::isValidIndex( tailIndex ) ) ) {
+        return false;
+    }
+
+    Bitboard target;
+    target.set( headIndex );
+    if ( unit.hasFlag( UNIT_WIDE ) ) {
+        target.set( tailIndex );
+    }
+
+    const Bitboard blocked = ( _occupiedCells & ~getUnitCells( unitId ) ) | _obstacleCells;
+    if ( !( target & blocked ).empty() ) {
+        return false;
+    }
+
+    _removeUnit( unitId );
+    unit.headIndex = headIndex;
+    unit.tailIndex = unit.hasFlag( UNIT_WIDE ) ? tailIndex : -1;
+    _placeUnit( unitId );
+
+    unit.modes |= TR_MOVED;
+    return true;
+}
+
+void Battle::Snapshot::newTurn()
+{
+    for ( UnitState & unit : _units ) {
+        if ( !unit.isValid() ) {
+            continue;
+        }
+
+        if ( unit.hasFlag( UNIT_REGENERATING ) ) {
+            unit.hitPoints = unit.count * unit.monsterHitPoints;
+        }
+
+        unit.modes &= ~( TR_RESPONSED | TR_MOVED | TR_HARDSKIP | TR_SKIPMOVE | LUCK_GOOD | LUCK_BAD | MORALE_GOOD | MORALE_BAD );
+
+        for ( uint32_t bit = 0; bit < 32; ++bit ) {
+            if ( unit.durations[bit] == 0 ) {
+                continue;
+            }
+
+            --unit.durations[bit];
+            if ( unit.durations[bit] == 0 ) {
+                unit.modes &= ~( 1u << bit );
+            }
+        }
+    }
+
+    // Mirror images disappear together with the spell on their owner
+    const bool hasMirrorOwner = std::any_of( _units.begin(), _units.end(), []( const UnitState & unit ) { return unit.isValid() && unit.isModes( CAP_MIRROROWNER ); } );
+    if ( !hasMirrorOwner ) {
+        for ( size_t i = 0; i < _units.size(); ++i ) {
+            if ( _units[i].isValid() && _units[i].isModes( CAP_MIRRORIMAGE ) ) {
+                _units[i].count = 0;
+                _units[i].hitPoints = 0;
+                _removeUnit( static_cast<int32_t>( i ) );
+            }
+        }
+    }
+}
+
+bool Battle::Snapshot::isFinished() const
+{
+    return getStrength( 0 ) <= 0 || getStrength( 1 ) <= 0;
+}
+
+double Battle::Snapshot::getStrength( const int side ) const
+{
+    double strength = 0;
+
+    for ( const UnitState & unit : _units ) {
+        if ( unit.isValid() && unit.side == side && !unit.isModes( CAP_MIRRORIMAGE ) ) {
+            strength += unit.strength * unit.hitPoints / unit.monsterHitPoints;
+        }
+    }
+
+    return strength;
+}
+
+void Battle::Snapshot::_placeUnit( const int32_t unitId )
+{
+    const UnitState & unit = _units[unitId];
+
+    _cellUnits[unit.headIndex] = static_cast<int8_t>( unitId );
+    _occupiedCells.set( unit.headIndex );
+
+    if ( unit.tailIndex >= 0 ) {
+        _cellUnits[unit.tailIndex] = static_cast<int8_t>( unitId );
+        _occupiedCells.set( unit.tailIndex );
+    }
+}
+
+void Battle::Snapshot::_removeUnit( const int32_t unitId )
+{
+    const UnitState & unit = _units[unitId];
+
+    for ( const int32_t index : { unit.headIndex, unit.tailIndex } ) {
+        if ( index >= 0 && _cellUnits[index] == unitId ) {
+            _cellUnits[index] = -1;
+            _occupiedCells.reset( index );
+        }
+    }
+}
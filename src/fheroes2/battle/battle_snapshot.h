@@ -0,0 +1,186 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef H2BATTLE_SNAPSHOT_H
+#define H2BATTLE_SNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "battle_bitboard.h"
+#include "battle_board.h"
+
+namespace Battle
+{
+    class Arena;
+    class Unit;
+
+    // A compact value-type copy of the battle state. Unlike Arena it does not own any interface, army or castle objects so it can be
+    // copied in a few microseconds and stepped by a search-based AI. Attack and damage rules mirror the ones of Battle::Unit and
+    // Battle::Arena except that area attacks, monster spell attacks and castle wall breaches are not modelled.
+    class Snapshot
+    {
+    public:
+        enum : uint32_t
+        {
+            UNIT_WIDE = 0x0001,
+            UNIT_FLYING = 0x0002,
+            UNIT_ARCHER = 0x0004,
+            UNIT_TWICE_ATTACK = 0x0008,
+            UNIT_ALWAYS_RETALIATE = 0x0010,
+            UNIT_IGNORE_RETALIATION = 0x0020,
+            UNIT_NO_MELEE_PENALTY = 0x0040,
+            UNIT_REGENERATING = 0x0080,
+            UNIT_UNLIMITED_SHOTS = 0x0100,
+            UNIT_NO_SHOOTING_PENALTY = 0x0200,
+            UNIT_BRIDGE_IS_MOAT = 0x0400,
+            UNIT_BLIND_ANSWER = 0x0800
+        };
+
+        struct UnitState
+        {
+            bool isValid() const
+            {
+                return count > 0;
+            }
+
+            bool hasFlag( const uint32_t flag ) const
+            {
+                return ( flags & flag ) != 0;
+            }
+
+            bool isModes( const uint32_t mode ) const
+            {
+                return ( modes & mode ) != 0;
+            }
+
+            uint32_t uid = 0;
+            int monsterId = 0;
+            // 0 for the attacking army, 1 for the defending one
+            int side = 0;
+            uint32_t flags = 0;
+            uint32_t modes = 0;
+
+            uint32_t count = 0;
+            uint32_t initialCount = 0;
+            uint32_t hitPoints = 0;
+            uint32_t monsterHitPoints = 0;
+
+            uint32_t attack = 0;
+            // Defense without the moat penalty which depends on the current position
+            uint32_t defense = 0;
+            // Damage of a single monster
+            uint32_t damageMin = 0;
+            uint32_t damageMax = 0;
+            uint32_t speed = 0;
+            uint32_t shots = 0;
+            uint32_t archeryBonus = 0;
+            int32_t luck = 0;
+
+            int32_t headIndex = -1;
+            int32_t tailIndex = -1;
+
+            // Remaining duration of every timed mode, indexed by the bit number of the mode
+            std::array<uint8_t, 32> durations;
+
+            double strength = 0;
+        };
+
+        explicit Snapshot( Arena & arena );
+        Snapshot( const Snapshot & ) = default;
+        Snapshot & operator=( const Snapshot & ) = default;
+
+        const std::vector<UnitState> & getUnits() const
+        {
+            return _units;
+        }
+
+        const UnitState & getUnit( const int32_t unitId ) const
+        {
+            return _units[unitId];
+        }
+
+        // Returns the id of the unit with the given UID or -1 if there is no such unit
+        int32_t findUnit( const uint32_t uid ) const;
+
+        // Returns the id of the unit occupying the given cell or -1 if the cell is empty
+        int32_t getUnitOnCell( const int32_t index ) const
+        {
+            return _cellUnits[index];
+        }
+
+        const Bitboard & getOccupiedCells() const
+        {
+            return _occupiedCells;
+        }
+
+        const Bitboard & getObstacleCells() const
+        {
+            return _obstacleCells;
+        }
+
+        Bitboard getUnitCells( const int32_t unitId ) const;
+        Bitboard getSideCells( const int side ) const;
+
+        bool isHandFighting( const int32_t unitId ) const;
+        bool isHandFighting( const int32_t attackerId, const int32_t defenderId ) const;
+
+        uint32_t getDefense( const int32_t unitId ) const;
+        uint32_t calculateDamage( const int32_t attackerId, const int32_t defenderId, double dmg ) const;
+
+        // Rolls the damage with the given generator, without the generator the average damage is returned and luck is not rolled
+        uint32_t getDamage( const int32_t attackerId, const int32_t defenderId, std::mt19937 * gen ) const;
+
+        // Returns the number of killed monsters
+        uint32_t applyDamage( const int32_t attackerId, const int32_t defenderId, uint32_t dmg );
+
+        // Melee or ranged attack including the retaliation and the second strike
+        void attack( const int32_t attackerId, const int32_t defenderId, std::mt19937 * gen );
+
+        // Moves the unit to the given position, tail index is ignored for narrow units
+        bool move( const int32_t unitId, const int32_t headIndex, const int32_t tailIndex );
+
+        void newTurn();
+
+        bool isFinished() const;
+        double getStrength( const int side ) const;
+
+    private:
+        void _addUnit( const UnitState & state );
+        void _strike( const int32_t attackerId, const int32_t defenderId, std::mt19937 * gen );
+        void _placeUnit( const int32_t unitId );
+        void _removeUnit( const int32_t unitId );
+        bool _isShootingPenalty( const UnitState & attacker, const UnitState & defender ) const;
+
+        std::vector<UnitState> _units;
+        std::array<int8_t, ARENASIZE> _cellUnits;
+
+        Bitboard _occupiedCells;
+        Bitboard _obstacleCells;
+
+        uint32_t _moatDefensePenalty = 0;
+        bool _hasCastle = false;
+        bool _areWallsIntact = false;
+    };
+}
+
+#endif
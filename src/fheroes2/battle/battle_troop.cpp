@@ -555,35 +555,40 @@ u32 Battle::Unit::CalculateDamageUnit( const Unit & enemy, double dmg ) const
     if ( enemy.Modes( SP_STONE ) )
         dmg /= 2;
 
+    return ApplyDamageModifiers( *this, enemy, GetAttack(), enemy.GetDefense(), Modes( SP_DRAGONSLAYER ), dmg );
+}
+
+u32 Battle::ApplyDamageModifiers( const Monster & attacker, const Monster & defender, const int attack, const int defense, const bool isDragonSlayer, double dmg )
+{
     // check monster capability
-    switch ( GetID() ) {
+    switch ( attacker.GetID() ) {
     case Monster::CRUSADER:
         // double damage for undead
-        if ( enemy.isUndead() )
+        if ( defender.isUndead() )
             dmg *= 2;
         break;
     case Monster::FIRE_ELEMENT:
-        if ( enemy.GetID() == Monster::WATER_ELEMENT )
+        if ( defender.GetID() == Monster::WATER_ELEMENT )
             dmg *= 2;
         break;
     case Monster::WATER_ELEMENT:
-        if ( enemy.GetID() == Monster::FIRE_ELEMENT )
+        if ( defender.GetID() == Monster::FIRE_ELEMENT )
             dmg *= 2;
         break;
     case Monster::AIR_ELEMENT:
-        if ( enemy.GetID() == Monster::EARTH_ELEMENT )
+        if ( defender.GetID() == Monster::EARTH_ELEMENT )
             dmg *= 2;
         break;
     case Monster::EARTH_ELEMENT:
-        if ( enemy.GetID() == Monster::AIR_ELEMENT )
+        if ( defender.GetID() == Monster::AIR_ELEMENT )
             dmg *= 2;
         break;
     default:
         break;
     }
 
-    int r = GetAttack() - enemy.GetDefense();
-    if ( enemy.isDragons() && Modes( SP_DRAGONSLAYER ) )
+    int r = attack - defense;
+    if ( defender.isDragons() && isDragonSlayer )
         r += Spell( Spell::DRAGONSLAYER ).ExtraValue();
 
     // Attack bonus is 20% to 300%
@@ -65,6 +65,9 @@ namespace Battle
         u32 FindZeroDuration( void ) const;
     };
 
+    // Monster specific damage bonuses and the attack/defense difference modifier, shared with Battle::Snapshot
+    u32 ApplyDamageModifiers( const Monster & attacker, const Monster & defender, const int attack, const int defense, const bool isDragonSlayer, double dmg );
+
     enum
     {
         CONTOUR_MAIN = 0,
@@ -42,6 +42,7 @@
 #include "m82.h"
 #include "maps_tiles.h"
 #include "morale.h"
+#include "parallel.h"
 #include "payment.h"
 #include "profit.h"
 #include "race.h"
@@ -95,10 +96,8 @@ Castle::Castle( s32 cx, s32 cy, int rc )
     army.SetCommander( &captain );
 }
 
-void Castle::LoadFromMP2( std::vector<uint8_t> & data )
+void Castle::LoadFromMP2( StreamBuf st )
 {
-    StreamBuf st( data );
-
     switch ( st.get() ) {
     case 0:
         SetColor( Color::BLUE );
@@ -1322,6 +1321,15 @@ bool Castle::BuyBuilding( u32 build )
     // add build
     building |= build;
 
+    // buildings affect stats of the captain and of the heroes staying in the castle
+    captain.invalidateStats();
+
+    CastleHeroes heroes = GetHeroes();
+    if ( heroes.Guest() )
+        heroes.Guest()->invalidateStats();
+    if ( heroes.Guard() )
+        heroes.Guard()->invalidateStats();
+
     switch ( build ) {
     case BUILD_CASTLE:
         building &= ~BUILD_TENT;
@@ -2483,6 +2491,11 @@ Castle * AllCastles::Get( const fheroes2::Point & position ) const
     return _castles[iter->second];
 }
 
+void AllCastles::NewWeek( const size_t seed )
+{
+    fheroes2::parallelForWithSeed( _castles.size(), seed, [this]( const size_t id ) { _castles[id]->ActionNewWeek(); } );
+}
+
 void AllCastles::Scoute( int colors ) const
 {
     for ( auto it = begin(); it != end(); ++it )
@@ -2621,6 +2634,11 @@ void Castle::SwapCastleHeroes( CastleHeroes & heroes )
 
         world.GetTiles( center.x, center.y ).SetHeroes( heroes.Guest() );
     }
+
+    if ( heroes.Guest() )
+        heroes.Guest()->invalidateStats();
+    if ( heroes.Guard() )
+        heroes.Guard()->invalidateStats();
 }
 
 std::string Castle::GetStringBuilding( u32 build ) const
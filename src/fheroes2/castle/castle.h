@@ -121,7 +121,7 @@ public:
     Castle( s32, s32, int rs );
     ~Castle() override = default;
 
-    void LoadFromMP2( std::vector<uint8_t> & data );
+    void LoadFromMP2( StreamBuf st );
 
     Captain & GetCaptain( void );
     const Captain & GetCaptain( void ) const;
@@ -365,10 +365,8 @@ public:
         std::for_each( _castles.begin(), _castles.end(), []( Castle * castle ) { castle->ActionNewDay(); } );
     }
 
-    void NewWeek()
-    {
-        std::for_each( _castles.begin(), _castles.end(), []( Castle * castle ) { castle->ActionNewWeek(); } );
-    }
+    // Castles grow independently from each other so they are processed in parallel with a random stream per castle.
+    void NewWeek( const size_t seed );
 
     void NewMonth()
     {
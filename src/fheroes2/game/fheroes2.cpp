@@ -25,6 +25,7 @@
 #include <string>
 
 #include "agg.h"
+#include "agg_image.h"
 #include "audio.h"
 #include "bin_info.h"
 #include "core.h"
@@ -36,6 +37,7 @@
 #include "image_palette.h"
 #include "localevent.h"
 #include "logging.h"
+#include "profiler.h"
 #include "screen.h"
 #include "settings.h"
 #include "system.h"
@@ -58,6 +60,8 @@ namespace
 #ifdef WITH_DEBUG
         COUT( "  -d <level>\tprint debug messages, see src/engine/logging.h for possible values of <level> argument" );
 #endif
+        COUT( "  -r <file>\trecord decisions of AI players to the file" );
+        COUT( "  -p <file>\treplay the game and compare decisions of AI players with the file recorded by -r option" );
         COUT( "  -h\t\tprint this help message and exit" );
 
         return EXIT_SUCCESS;
@@ -168,13 +172,19 @@ int main( int argc, char ** argv )
         // getopt
         {
             int opt;
-            while ( ( opt = System::GetCommandOptions( argc, argv, "hd:" ) ) != -1 )
+            while ( ( opt = System::GetCommandOptions( argc, argv, "hd:r:p:" ) ) != -1 )
                 switch ( opt ) {
 #ifdef WITH_DEBUG
                 case 'd':
                     conf.SetDebug( System::GetOptionsArgument() ? GetInt( System::GetOptionsArgument() ) : 0 );
                     break;
 #endif
+                case 'r':
+                case 'p':
+                    if ( System::GetOptionsArgument() )
+                        conf.setAIActionLog( System::GetOptionsArgument(), opt == 'p' );
+                    break;
+
                 case '?':
                 case 'h':
                     return PrintHelp( argv[0] );
@@ -207,6 +217,9 @@ int main( int argc, char ** argv )
 
         const AGG::AGGInitializer aggInitializer;
 
+        fheroes2::AGG::SetImageCacheLimit( static_cast<size_t>( conf.imageCacheLimit() ) * 1024 * 1024 );
+        AGG::SetSoundCacheLimit( static_cast<size_t>( conf.soundCacheLimit() ) * 1024 * 1024 );
+
         // Load palette.
         fheroes2::setGamePalette( AGG::ReadChunk( "KB.PAL" ) );
 
@@ -218,6 +231,10 @@ int main( int argc, char ** argv )
 
         conf.setGameLanguage( conf.getGameLanguage() );
 
+        if ( conf.isResourcePreloadEnabled() ) {
+            fheroes2::AGG::WarmUpCache();
+        }
+
         if ( conf.isShowIntro() ) {
             fheroes2::showTeamInfo();
 
@@ -228,6 +245,10 @@ int main( int argc, char ** argv )
         const CursorRestorer cursorRestorer( true, Cursor::POINTER );
 
         Game::mainGameLoop( conf.isFirstGameRun() );
+
+#ifdef WITH_PROFILER
+        fheroes2::Profiler::saveChromeTrace( System::ConcatePath( System::GetConfigDirectory( "fheroes2" ), "fheroes2_trace.json" ) );
+#endif
     }
     catch ( const std::exception & ex ) {
         ERROR_LOG( "Exception '" << ex.what() << "' occured during application runtime." );
@@ -33,6 +33,7 @@
 #include "game_credits.h"
 #include "game_delays.h"
 #include "game_interface.h"
+#include "game_session.h"
 #include "game_static.h"
 #include "icn.h"
 #include "m82.h"
@@ -40,7 +41,6 @@
 #include "monster.h"
 #include "mp2.h"
 #include "rand.h"
-#include "save_format_version.h"
 #include "settings.h"
 #include "skill.h"
 #include "text.h"
@@ -53,8 +53,6 @@ namespace
     std::string lastMapFileName;
     std::vector<Player> savedPlayers;
 
-    int save_version = CURRENT_FORMAT_VERSION;
-
     std::string last_name;
 
     bool updateSoundsOnFocusUpdate = true;
@@ -144,7 +142,7 @@ void Game::LoadPlayers( const std::string & mapFileName, Players & players )
         player->SetFriends( p.GetFriends() );
         player->SetName( p.GetName() );
         players.push_back( player );
-        Players::Set( Color::GetIndex( p.GetColor() ), player );
+        players.Set( Color::GetIndex( p.GetColor() ), player );
     }
 }
 
@@ -169,12 +167,12 @@ void Game::SavePlayers( const std::string & mapFileName, const Players & players
 
 void Game::SetLoadVersion( int ver )
 {
-    save_version = ver;
+    Session::Get().setLoadVersion( ver );
 }
 
 int Game::GetLoadVersion( void )
 {
-    return save_version;
+    return Session::Get().getLoadVersion();
 }
 
 const std::string & Game::GetLastSavename( void )
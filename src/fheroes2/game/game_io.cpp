@@ -30,6 +30,7 @@
 #include "game_static.h"
 #include "logging.h"
 #include "monster.h"
+#include "profiler.h"
 #include "save_format_version.h"
 #include "settings.h"
 #include "system.h"
@@ -97,6 +98,8 @@ bool Game::AutoSave()
 
 bool Game::Save( const std::string & fn )
 {
+    PROFILE_ZONE( "Game::Save" );
+
     DEBUG_LOG( DBG_GAME, DBG_INFO, fn );
     const bool autosave = ( System::GetBasename( fn ) == "AUTOSAVE" + GetSaveFileExtension() );
     const Settings & conf = Settings::Get();
@@ -134,6 +137,8 @@ bool Game::Save( const std::string & fn )
 
 fheroes2::GameMode Game::Load( const std::string & fn )
 {
+    PROFILE_ZONE( "Game::Load" );
+
     DEBUG_LOG( DBG_GAME, DBG_INFO, fn );
 
     StreamFile fs;
@@ -68,6 +68,9 @@ void Game::mainGameLoop( bool isFirstGameRun )
     fheroes2::GameMode result = fheroes2::GameMode::MAIN_MENU;
 
     while ( result != fheroes2::GameMode::QUIT_GAME ) {
+        // No images are in use while switching between game screens.
+        fheroes2::AGG::ReleaseUnusedImages();
+
         switch ( result ) {
         case fheroes2::GameMode::MAIN_MENU:
             result = Game::MainMenu( isFirstGameRun );
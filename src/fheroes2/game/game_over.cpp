@@ -27,6 +27,7 @@
 #include "dialog.h"
 #include "game.h"
 #include "game_interface.h"
+#include "game_session.h"
 #include "game_video.h"
 #include "gamedefs.h"
 #include "kingdom.h"
@@ -273,8 +274,7 @@ std::string GameOver::GetActualDescription( uint32_t cond )
 
 GameOver::Result & GameOver::Result::Get( void )
 {
-    static Result gresult;
-    return gresult;
+    return Game::Session::Get().getResult();
 }
 
 GameOver::Result::Result()
@@ -29,6 +29,11 @@
 
 class StreamBase;
 
+namespace Game
+{
+    class Session;
+}
+
 namespace GameOver
 {
     enum conditions_t : uint32_t
@@ -75,6 +80,7 @@ namespace GameOver
     private:
         friend StreamBase & operator<<( StreamBase &, const Result & );
         friend StreamBase & operator>>( StreamBase &, Result & );
+        friend class Game::Session;
 
         Result();
 
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cassert>
+
+#include "ai_action_log.h"
+#include "game_over.h"
+#include "game_session.h"
+#include "normal/ai_normal.h"
+#include "save_format_version.h"
+#include "settings.h"
+#include "world.h"
+
+namespace
+{
+    // A thread which has accessed the default session cannot enter another one as the global world reference is already bound.
+    thread_local bool isDefaultSessionUsed = false;
+}
+
+namespace Game
+{
+    Session::Session()
+        : Session( true )
+    {}
+
+    Session::Session( const bool isHeadless )
+        : _settings( new Settings )
+        , _result( new GameOver::Result )
+        , _ai( new AI::Normal )
+        , _actionLog( new AI::ActionLog )
+        , _world( new World )
+        , _loadVersion( CURRENT_FORMAT_VERSION )
+        , _isHeadless( isHeadless )
+    {}
+
+    Session::~Session()
+    {
+        if ( _isHeadless ) {
+            // The world and the AI use the game state while being destroyed so it has to be the state of this session.
+            // Headless sessions must be destroyed by the thread which ran them.
+            fheroes2::ThreadContext * previousContext = fheroes2::getThreadContext();
+            fheroes2::setThreadContext( this );
+
+            _world.reset();
+            _ai.reset();
+            _result.reset();
+
+            fheroes2::setThreadContext( previousContext );
+        }
+        else if ( !_settings->LoadedGameVersion() ) {
+            // Only the user interface settings are stored in the configuration directory.
+            _settings->BinarySave();
+        }
+    }
+
+    Session & Session::Get()
+    {
+        fheroes2::ThreadContext * context = fheroes2::getThreadContext();
+        if ( context != nullptr ) {
+            return static_cast<Session &>( *context );
+        }
+
+        isDefaultSessionUsed = true;
+        return getDefault();
+    }
+
+    Session & Session::getDefault()
+    {
+        static Session session( false );
+        return session;
+    }
+
+    SessionScope::SessionScope( Session & session )
+    {
+        assert( session.isHeadless() );
+        assert( fheroes2::getThreadContext() == nullptr && !isDefaultSessionUsed );
+
+        fheroes2::setThreadContext( &session );
+    }
+
+    SessionScope::~SessionScope()
+    {
+        fheroes2::setThreadContext( nullptr );
+    }
+}
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef H2GAME_SESSION_H
+#define H2GAME_SESSION_H
+
+#include <memory>
+
+#include "parallel.h"
+
+class Settings;
+class World;
+
+namespace AI
+{
+    class ActionLog;
+    class Base;
+}
+
+namespace GameOver
+{
+    class Result;
+}
+
+namespace Game
+{
+    // A session owns the whole state of one game: the settings with the players, the world with the kingdoms and the random streams,
+    // the game result, the AI state and the AI action log. World::Get(), Settings::Get() and other accessors of the game state return the objects of
+    // the session of the calling thread. The main thread uses the default session which also drives the user interface.
+    //
+    // Other sessions are headless and can only host AI-only games. Each of them has to run on its own thread which must not access
+    // the game state before entering the session with SessionScope and after leaving it. Asset caches and monster, spell and animation
+    // data are shared by all sessions: they are loaded by the main thread before other sessions are started and only read afterwards.
+    class Session : public fheroes2::ThreadContext
+    {
+    public:
+        Session();
+        Session( const Session & ) = delete;
+        Session & operator=( const Session & ) = delete;
+
+        ~Session() override;
+
+        // Returns the session of the calling thread.
+        static Session & Get();
+
+        bool isHeadless() const
+        {
+            return _isHeadless;
+        }
+
+        Settings & getSettings()
+        {
+            return *_settings;
+        }
+
+        World & getWorld()
+        {
+            return *_world;
+        }
+
+        GameOver::Result & getResult()
+        {
+            return *_result;
+        }
+
+        AI::Base & getAI()
+        {
+            return *_ai;
+        }
+
+        AI::ActionLog & getActionLog()
+        {
+            return *_actionLog;
+        }
+
+        // Format version of the save file being loaded
+        int getLoadVersion() const
+        {
+            return _loadVersion;
+        }
+
+        void setLoadVersion( const int version )
+        {
+            _loadVersion = version;
+        }
+
+    private:
+        explicit Session( const bool isHeadless );
+
+        static Session & getDefault();
+
+        // The world is destroyed first because heroes and castles use the rest of the session while being removed.
+        std::unique_ptr<Settings> _settings;
+        std::unique_ptr<GameOver::Result> _result;
+        std::unique_ptr<AI::Base> _ai;
+        std::unique_ptr<AI::ActionLog> _actionLog;
+        std::unique_ptr<World> _world;
+
+        int _loadVersion;
+        bool _isHeadless;
+    };
+
+    // Makes the given session the session of the calling thread until the end of the scope.
+    class SessionScope
+    {
+    public:
+        explicit SessionScope( Session & session );
+        SessionScope( const SessionScope & ) = delete;
+        SessionScope & operator=( const SessionScope & ) = delete;
+
+        ~SessionScope();
+    };
+}
+
+#endif
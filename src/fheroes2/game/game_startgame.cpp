@@ -26,6 +26,7 @@
 #include "agg.h"
 #include "agg_image.h"
 #include "ai.h"
+#include "ai_action_log.h"
 #include "audio.h"
 #include "battle_only.h"
 #include "castle.h"
@@ -36,6 +37,7 @@
 #include "game_interface.h"
 #include "game_io.h"
 #include "game_over.h"
+#include "game_session.h"
 #include "heroes.h"
 #include "icn.h"
 #include "kingdom.h"
@@ -75,6 +77,13 @@ fheroes2::GameMode Game::StartGame()
 
     const Settings & conf = Settings::Get();
 
+    AI::ActionLog & actionLog = Game::Session::Get().getActionLog();
+    if ( !conf.getAIActionLogFile().empty() && actionLog.open( conf.getAIActionLogFile(), conf.isAIActionLogReplay(), world.GetMapSeed(), world.CountDay() ) ) {
+        // Battles and other parts of the game draw their values from the random generator of the thread. It is reseeded with the map seed
+        // for a recorded game and its replay to make the same decisions.
+        Rand::CurrentThreadRandomDevice().seed( world.GetMapSeed() );
+    }
+
     // setup cursor
     const CursorRestorer cursorRestorer( true, Cursor::POINTER );
 
@@ -85,7 +94,11 @@ fheroes2::GameMode Game::StartGame()
 
     Interface::Basic::Get().Reset();
 
-    return Interface::Basic::Get().StartGame();
+    const fheroes2::GameMode result = Interface::Basic::Get().StartGame();
+
+    actionLog.close();
+
+    return result;
 }
 
 void Game::DialogPlayers( int color, std::string str )
@@ -569,6 +582,9 @@ fheroes2::GameMode Interface::Basic::StartGame()
     std::sort( sortedPlayers.begin(), sortedPlayers.end(), SortPlayers );
 
     while ( res == fheroes2::GameMode::END_TURN ) {
+        // The adventure map interface redraws everything from scratch so this is a safe place to release unused images.
+        fheroes2::AGG::ReleaseUnusedImages();
+
         if ( !loadedFromSave ) {
             world.NewDay();
         }
@@ -35,6 +35,9 @@ namespace
     // Anim2 directory is used in Russian Buka version of the game.
     const std::vector<std::string> videoDir = { "anim", "anim2", System::ConcatePath( "heroes2", "anim" ), "data" };
 
+    // Number of video frames decoded ahead of time
+    const size_t videoFrameQueueSize = 8;
+
     void drawRectangle( const fheroes2::Rect & roi, fheroes2::Image & image, const uint8_t color )
     {
         fheroes2::DrawRect( image, roi, color );
@@ -111,6 +114,10 @@ namespace Video
             return 0;
         }
 
+        // Frames are decoded on a separate thread while the main thread only draws them so decoding time doesn't affect playback cadence.
+        // Audio channels are fully decoded while opening the video and are already queued in the mixer at this point.
+        SMKVideoFrameQueue frameQueue( video, videoFrameQueueSize, isLooped );
+
         std::vector<uint8_t> palette;
         std::vector<uint8_t> prevPalette;
 
@@ -162,10 +169,7 @@ namespace Video
 
             if ( Game::validateCustomAnimationDelay( delay ) ) {
                 if ( !isFrameReady ) {
-                    if ( currentFrame == 0 )
-                        video.resetFrame();
-
-                    video.getNextFrame( display, frameRoi.x, frameRoi.y, frameRoi.width, frameRoi.height, palette );
+                    frameQueue.getNextFrame( display, frameRoi.x, frameRoi.y, frameRoi.width, frameRoi.height, palette );
 
                     for ( size_t i = 0; i < roi.size(); ++i ) {
                         if ( le.MouseCursor( roi[i] ) ) {
@@ -199,10 +203,7 @@ namespace Video
             else {
                 // Don't waste CPU resources, do some calculations while we're waiting for the next frame time position
                 if ( !isFrameReady ) {
-                    if ( currentFrame == 0 )
-                        video.resetFrame();
-
-                    video.getNextFrame( display, frameRoi.x, frameRoi.y, frameRoi.width, frameRoi.height, palette );
+                    frameQueue.getNextFrame( display, frameRoi.x, frameRoi.y, frameRoi.width, frameRoi.height, palette );
 
                     for ( size_t i = 0; i < roi.size(); ++i ) {
                         if ( le.MouseCursor( roi[i] ) ) {
@@ -31,6 +31,7 @@
 #include "logging.h"
 #include "maps.h"
 #include "pal.h"
+#include "profiler.h"
 #include "route.h"
 #include "settings.h"
 #include "tools.h"
@@ -147,6 +148,8 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
 
 void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
 {
+    PROFILE_ZONE( "GameArea::Redraw" );
+
     const fheroes2::Rect & tileROI = GetVisibleTileROI();
 
     int32_t minX = tileROI.x;
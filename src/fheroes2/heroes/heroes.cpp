@@ -47,6 +47,7 @@
 #include "monster.h"
 #include "morale.h"
 #include "mp2.h"
+#include "parallel.h"
 #include "payment.h"
 #include "race.h"
 #include "serialize.h"
@@ -298,6 +299,8 @@ void Heroes::LoadFromMP2( s32 map_index, int cl, int rc, StreamBuf st )
         for ( std::vector<Skill::Secondary>::const_iterator it = secs.begin(); it != secs.end(); ++it )
             if ( ( *it ).isValid() )
                 secondary_skills.AddSkill( *it );
+
+        invalidateStats();
     }
     else {
         st.skip( 16 );
@@ -442,10 +445,15 @@ double Heroes::getMeetingValue( const Heroes & recievingHero ) const
 
 int Heroes::GetAttack( void ) const
 {
-    return GetAttack( nullptr );
+    return _getStatBlock().attack;
 }
 
 int Heroes::GetAttack( std::string * strs ) const
+{
+    return strs == nullptr ? GetAttack() : _calculateAttack( strs );
+}
+
+int Heroes::_calculateAttack( std::string * strs ) const
 {
     int result = attack + GetAttackModificator( strs );
     return result < 0 ? 0 : ( result > 255 ? 255 : result );
@@ -453,10 +461,15 @@ int Heroes::GetAttack( std::string * strs ) const
 
 int Heroes::GetDefense( void ) const
 {
-    return GetDefense( nullptr );
+    return _getStatBlock().defense;
 }
 
 int Heroes::GetDefense( std::string * strs ) const
+{
+    return strs == nullptr ? GetDefense() : _calculateDefense( strs );
+}
+
+int Heroes::_calculateDefense( std::string * strs ) const
 {
     int result = defense + GetDefenseModificator( strs );
     return result < 0 ? 0 : ( result > 255 ? 255 : result );
@@ -464,10 +477,15 @@ int Heroes::GetDefense( std::string * strs ) const
 
 int Heroes::GetPower( void ) const
 {
-    return GetPower( nullptr );
+    return _getStatBlock().power;
 }
 
 int Heroes::GetPower( std::string * strs ) const
+{
+    return strs == nullptr ? GetPower() : _calculatePower( strs );
+}
+
+int Heroes::_calculatePower( std::string * strs ) const
 {
     const int result = power + GetPowerModificator( strs );
     return result < 1 ? 1 : ( result > 255 ? 255 : result );
@@ -475,10 +493,15 @@ int Heroes::GetPower( std::string * strs ) const
 
 int Heroes::GetKnowledge( void ) const
 {
-    return GetKnowledge( nullptr );
+    return _getStatBlock().knowledge;
 }
 
 int Heroes::GetKnowledge( std::string * strs ) const
+{
+    return strs == nullptr ? GetKnowledge() : _calculateKnowledge( strs );
+}
+
+int Heroes::_calculateKnowledge( std::string * strs ) const
 {
     int result = knowledge + GetKnowledgeModificator( strs );
     return result < 0 ? 0 : ( result > 255 ? 255 : result );
@@ -502,6 +525,8 @@ void Heroes::IncreasePrimarySkill( int skill )
     default:
         break;
     }
+
+    invalidateStats();
 }
 
 u32 Heroes::GetExperience( void ) const
@@ -594,10 +619,15 @@ u32 Heroes::GetMaxMovePoints( void ) const
 
 int Heroes::GetMorale( void ) const
 {
-    return GetMoraleWithModificators( nullptr );
+    return _getStatBlock().morale;
 }
 
 int Heroes::GetMoraleWithModificators( std::string * strs ) const
+{
+    return strs == nullptr ? GetMorale() : _calculateMorale( strs );
+}
+
+int Heroes::_calculateMorale( std::string * strs ) const
 {
     int result = Morale::NORMAL;
 
@@ -608,8 +638,8 @@ int Heroes::GetMoraleWithModificators( std::string * strs ) const
     result += Skill::GetLeadershipModifiers( GetLevelSkill( Skill::Secondary::LEADERSHIP ), strs );
 
     // object visited
-    const std::vector<MP2::MapObjectType> objectTypes{ MP2::OBJ_BUOY,      MP2::OBJ_OASIS,        MP2::OBJ_WATERINGHOLE, MP2::OBJ_TEMPLE,
-                                                       MP2::OBJ_GRAVEYARD, MP2::OBJ_DERELICTSHIP, MP2::OBJ_SHIPWRECK };
+    static const std::vector<MP2::MapObjectType> objectTypes{ MP2::OBJ_BUOY,      MP2::OBJ_OASIS,        MP2::OBJ_WATERINGHOLE, MP2::OBJ_TEMPLE,
+                                                              MP2::OBJ_GRAVEYARD, MP2::OBJ_DERELICTSHIP, MP2::OBJ_SHIPWRECK };
     result += ObjectVisitedModifiersResult( objectTypes, *this, strs );
 
     // result
@@ -618,10 +648,15 @@ int Heroes::GetMoraleWithModificators( std::string * strs ) const
 
 int Heroes::GetLuck( void ) const
 {
-    return GetLuckWithModificators( nullptr );
+    return _getStatBlock().luck;
 }
 
 int Heroes::GetLuckWithModificators( std::string * strs ) const
+{
+    return strs == nullptr ? GetLuck() : _calculateLuck( strs );
+}
+
+int Heroes::_calculateLuck( std::string * strs ) const
 {
     int result = Luck::NORMAL;
 
@@ -632,12 +667,44 @@ int Heroes::GetLuckWithModificators( std::string * strs ) const
     result += Skill::GetLuckModifiers( GetLevelSkill( Skill::Secondary::LUCK ), strs );
 
     // object visited
-    const std::vector<MP2::MapObjectType> objectTypes{ MP2::OBJ_MERMAID, MP2::OBJ_FAERIERING, MP2::OBJ_FOUNTAIN, MP2::OBJ_IDOL, MP2::OBJ_PYRAMID };
+    static const std::vector<MP2::MapObjectType> objectTypes{ MP2::OBJ_MERMAID, MP2::OBJ_FAERIERING, MP2::OBJ_FOUNTAIN, MP2::OBJ_IDOL, MP2::OBJ_PYRAMID };
     result += ObjectVisitedModifiersResult( objectTypes, *this, strs );
 
     return Luck::Normalize( result );
 }
 
+void Heroes::_calculateStatBlock( StatBlock & block ) const
+{
+    block.attack = _calculateAttack( nullptr );
+    block.defense = _calculateDefense( nullptr );
+    block.power = _calculatePower( nullptr );
+    block.knowledge = _calculateKnowledge( nullptr );
+    block.morale = _calculateMorale( nullptr );
+    block.luck = _calculateLuck( nullptr );
+}
+
+const Heroes::StatBlock & Heroes::_getStatBlock() const
+{
+    if ( !_statBlock.isValid || _statBlock.statsVersion != getStatsVersion() || _statBlock.troopsVersion != army.getTroopsVersion() ) {
+        _calculateStatBlock( _statBlock );
+        _statBlock.statsVersion = getStatsVersion();
+        _statBlock.troopsVersion = army.getTroopsVersion();
+        _statBlock.isValid = true;
+    }
+#ifdef WITH_DEBUG
+    else if ( IS_DEVEL() ) {
+        StatBlock block;
+        _calculateStatBlock( block );
+        if ( block.attack != _statBlock.attack || block.defense != _statBlock.defense || block.power != _statBlock.power || block.knowledge != _statBlock.knowledge
+             || block.morale != _statBlock.morale || block.luck != _statBlock.luck ) {
+            ERROR_LOG( "cached stats of hero " << name << " differ from the actual values" )
+        }
+    }
+#endif
+
+    return _statBlock;
+}
+
 /* recrut hero */
 bool Heroes::Recruit( int cl, const fheroes2::Point & pt )
 {
@@ -653,6 +720,8 @@ bool Heroes::Recruit( int cl, const fheroes2::Point & pt )
         SetColor( cl );
         killer_color.SetColor( Color::NONE );
         SetCenter( pt );
+        // the hero might be recruited in a castle
+        invalidateStats();
         setDirection( Direction::RIGHT );
         if ( !Modes( SAVE_MP_POINTS ) )
             move_point = GetMaxMovePoints();
@@ -694,7 +763,8 @@ void Heroes::ActionNewDay( void )
     ReplenishSpellPoints();
 
     // remove day visit object
-    visit_object.remove_if( Visit::isDayLife );
+    visit_object.removeIf( Visit::isDayLife );
+    invalidateStats();
 
     // new day, new capacities
     ResetModes( SAVE_MP_POINTS );
@@ -703,19 +773,22 @@ void Heroes::ActionNewDay( void )
 void Heroes::ActionNewWeek( void )
 {
     // remove week visit object
-    visit_object.remove_if( Visit::isWeekLife );
+    visit_object.removeIf( Visit::isWeekLife );
+    invalidateStats();
 }
 
 void Heroes::ActionNewMonth( void )
 {
     // remove month visit object
-    visit_object.remove_if( Visit::isMonthLife );
+    visit_object.removeIf( Visit::isMonthLife );
+    invalidateStats();
 }
 
 void Heroes::ActionAfterBattle( void )
 {
     // remove month visit object
-    visit_object.remove_if( Visit::isBattleLife );
+    visit_object.removeIf( Visit::isBattleLife );
+    invalidateStats();
 
     SetModes( ACTION );
 }
@@ -770,6 +843,11 @@ void Heroes::calculatePath( int32_t dstIdx )
         return;
     }
 
+    // A hero which went one step aside continues on the existing path.
+    if ( dstIdx == path.GetDestinationIndex() && PlayerWorldPathfinder::reconnectPath( *this, path ) ) {
+        return;
+    }
+
     path.setPath( world.getPath( *this, dstIdx ), dstIdx );
 
     if ( !path.isValid() ) {
@@ -811,7 +889,7 @@ bool Heroes::isVisited( const Maps::Tiles & tile, Visit::type_t type ) const
     if ( Visit::GLOBAL == type )
         return GetKingdom().isVisited( index, objectType );
 
-    return visit_object.end() != std::find( visit_object.begin(), visit_object.end(), IndexObject( index, objectType ) );
+    return visit_object.isVisited( index, objectType );
 }
 
 bool Heroes::isObjectTypeVisited( const MP2::MapObjectType objectType, Visit::type_t type ) const
@@ -819,7 +897,7 @@ bool Heroes::isObjectTypeVisited( const MP2::MapObjectType objectType, Visit::ty
     if ( Visit::GLOBAL == type )
         return GetKingdom().isVisited( objectType );
 
-    return std::any_of( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } );
+    return visit_object.isObjectTypeVisited( objectType );
 }
 
 void Heroes::SetVisited( s32 index, Visit::type_t type )
@@ -831,7 +909,8 @@ void Heroes::SetVisited( s32 index, Visit::type_t type )
         GetKingdom().SetVisited( index, objectType );
     }
     else if ( !isVisited( tile ) && MP2::OBJ_ZERO != objectType ) {
-        visit_object.push_front( IndexObject( index, objectType ) );
+        visit_object.add( index, objectType );
+        invalidateStats();
     }
 }
 
@@ -877,7 +956,7 @@ void Heroes::SetVisitedWideTile( s32 index, const MP2::MapObjectType objectType,
 void Heroes::markHeroMeeting( int heroID )
 {
     if ( heroID < UNKNOWN && !hasMetWithHero( heroID ) )
-        visit_object.push_front( IndexObject( heroID, MP2::OBJ_HEROES ) );
+        visit_object.add( heroID, MP2::OBJ_HEROES );
 }
 
 void Heroes::unmarkHeroMeeting()
@@ -888,14 +967,14 @@ void Heroes::unmarkHeroMeeting()
             continue;
         }
 
-        hero->visit_object.remove( IndexObject( hid, MP2::OBJ_HEROES ) );
-        visit_object.remove( IndexObject( hero->hid, MP2::OBJ_HEROES ) );
+        hero->visit_object.remove( hid, MP2::OBJ_HEROES );
+        visit_object.remove( hero->hid, MP2::OBJ_HEROES );
     }
 }
 
 bool Heroes::hasMetWithHero( int heroID ) const
 {
-    return visit_object.end() != std::find( visit_object.begin(), visit_object.end(), IndexObject( heroID, MP2::OBJ_HEROES ) );
+    return visit_object.isVisited( heroID, MP2::OBJ_HEROES );
 }
 
 int Heroes::GetSpriteIndex( void ) const
@@ -957,6 +1036,8 @@ bool Heroes::PickupArtifact( const Artifact & art )
 
     // check: artifact sets such as anduran garb
     const auto assembledArtifacts = bag_artifacts.assembleArtifactSetIfPossible();
+    invalidateStats();
+
     if ( isControlHuman() ) {
         for ( const ArtifactSetData & artifactSetData : assembledArtifacts )
             Dialog::ArtifactInfo( "", artifactSetData._assembleMessage, artifactSetData._assembledArtifactID );
@@ -1247,8 +1328,10 @@ int Heroes::GetLevelSkill( int skill ) const
 
 void Heroes::LearnSkill( const Skill::Secondary & skill )
 {
-    if ( skill.isValid() )
+    if ( skill.isValid() ) {
         secondary_skills.AddSkill( skill );
+        invalidateStats();
+    }
 }
 
 void Heroes::Scoute( const int tileIndex ) const
@@ -1338,6 +1421,7 @@ void Heroes::LevelUp( bool skipsecondary, bool autoselect )
 
     // level up primary skill
     const int primarySkill = Skill::Primary::LevelUp( _race, GetLevel(), seeds.seedPrimarySkill );
+    invalidateStats();
 
     DEBUG_LOG( DBG_GAME, DBG_INFO, "for " << GetName() << ", up " << Skill::Primary::String( primarySkill ) );
 
@@ -1383,6 +1467,8 @@ void Heroes::LevelUpSecondarySkill( const HeroSeedsForLevelUp & seeds, int prima
         else
             secondary_skills.AddSkill( Skill::Secondary( selected.Skill(), Skill::Level::BASIC ) );
 
+        invalidateStats();
+
         // post action
         if ( selected.Skill() == Skill::Secondary::SCOUTING ) {
             Scoute( GetIndex() );
@@ -1459,6 +1545,7 @@ void Heroes::SetFreeman( int reason )
         world.GetTiles( GetIndex() ).SetHeroes( nullptr );
         modes = 0;
         SetIndex( -1 );
+        invalidateStats();
         move_point_scale = -1;
         path.Reset();
         SetMove( false );
@@ -1567,6 +1654,8 @@ void Heroes::Move2Dest( const int32_t dstIndex )
     if ( dstIndex != GetIndex() ) {
         world.GetTiles( GetIndex() ).SetHeroes( nullptr );
         SetIndex( dstIndex );
+        // the hero might enter or leave a castle
+        invalidateStats();
         Scoute( dstIndex );
         world.GetTiles( dstIndex ).SetHeroes( this );
     }
@@ -1696,7 +1785,8 @@ std::string Heroes::String( void ) const
 
     if ( !visit_object.empty() ) {
         os << "visit objects   : ";
-        for ( std::list<IndexObject>::const_iterator it = visit_object.begin(); it != visit_object.end(); ++it )
+        const std::vector<IndexObject> & objects = visit_object.objects();
+        for ( std::vector<IndexObject>::const_reverse_iterator it = objects.rbegin(); it != objects.rend(); ++it )
             os << MP2::StringObject( static_cast<MP2::MapObjectType>( ( *it ).second ) ) << "(" << ( *it ).first << "), ";
         os << std::endl;
     }
@@ -1917,6 +2007,11 @@ Heroes * AllHeroes::GetFreemanSpecial( int heroID ) const
     return at( heroID );
 }
 
+void AllHeroes::NewDay()
+{
+    fheroes2::parallelFor( size(), [this]( const size_t id ) { ( *this )[id]->ActionNewDay(); } );
+}
+
 void AllHeroes::Scoute( int colors ) const
 {
     for ( const_iterator it = begin(); it != end(); ++it )
@@ -2032,6 +2127,7 @@ StreamBase & operator>>( StreamBase & msg, Heroes & hero )
     msg >> hero.patrol_square >> hero.visit_object >> hero._lastGroundRegion;
 
     hero.army.SetCommander( &hero );
+    hero._statBlock = Heroes::StatBlock();
     return msg;
 }
 
@@ -451,7 +451,7 @@ private:
     fheroes2::Point patrol_center;
     int patrol_square;
 
-    std::list<IndexObject> visit_object;
+    VisitedObjects visit_object;
     uint32_t _lastGroundRegion = 0;
 
     RedrawIndex _redrawIndex;
@@ -463,6 +463,34 @@ private:
     // This value should NOT be saved in save file as it's dynamically set during AI turn.
     Role _aiRole;
 
+    // Primary skills, morale and luck with all modificators are requested by army strength evaluation, battles and AI very often.
+    // They are recalculated only when the stats version of the hero or the troops version of the army changes.
+    struct StatBlock
+    {
+        uint32_t statsVersion = 0;
+        uint32_t troopsVersion = 0;
+        bool isValid = false;
+        int attack = 0;
+        int defense = 0;
+        int power = 0;
+        int knowledge = 0;
+        int morale = 0;
+        int luck = 0;
+    };
+
+    mutable StatBlock _statBlock;
+
+    const StatBlock & _getStatBlock() const;
+    void _calculateStatBlock( StatBlock & block ) const;
+
+    // Slow path calculations also used to explain the values in UI when a string is provided.
+    int _calculateAttack( std::string * strs ) const;
+    int _calculateDefense( std::string * strs ) const;
+    int _calculatePower( std::string * strs ) const;
+    int _calculateKnowledge( std::string * strs ) const;
+    int _calculateMorale( std::string * strs ) const;
+    int _calculateLuck( std::string * strs ) const;
+
     enum
     {
         HERO_MOVE_STEP = 4 // in pixels
@@ -489,10 +517,8 @@ struct AllHeroes : public VecHeroes
 
     void Scoute( int ) const;
 
-    void NewDay()
-    {
-        std::for_each( begin(), end(), []( Heroes * hero ) { hero->ActionNewDay(); } );
-    }
+    // Move and spell points of every hero are restored independently so heroes are processed in parallel.
+    void NewDay();
 
     void NewWeek()
     {
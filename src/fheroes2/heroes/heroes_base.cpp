@@ -154,6 +154,7 @@ void HeroBase::LoadDefaults( const int type, const int race )
     if ( Race::ALL & race ) {
         // fixed default primary skills
         Skill::Primary::LoadDefaults( type, race );
+        invalidateStats();
 
         // fixed default spell
         switch ( type ) {
@@ -251,7 +252,11 @@ void HeroBase::AppendSpellsToBook( const SpellStorage & spells, const bool witho
 
 bool HeroBase::SpellBookActivate()
 {
-    return !HaveSpellBook() && bag_artifacts.PushArtifact( Artifact::MAGIC_BOOK );
+    if ( HaveSpellBook() || !bag_artifacts.PushArtifact( Artifact::MAGIC_BOOK ) )
+        return false;
+
+    invalidateStats();
+    return true;
 }
 
 const BagArtifacts & HeroBase::GetBagArtifacts() const
@@ -499,6 +504,7 @@ void HeroBase::TranscribeScroll( const Artifact & art )
 
         // remove art
         bag_artifacts.RemoveScroll( art );
+        invalidateStats();
 
         // reduce mp and resource
         SpellCasted( spell );
@@ -522,5 +528,6 @@ StreamBase & operator>>( StreamBase & msg, HeroBase & hero )
         // modes
         hero.modes >> hero.magic_point >> hero.move_point >> hero.spell_book >> hero.bag_artifacts;
 
+    hero.invalidateStats();
     return msg;
 }
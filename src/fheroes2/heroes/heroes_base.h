@@ -123,6 +123,18 @@ public:
 
     void LoadDefaults( const int type, const int race );
 
+    // Returns the version of everything affecting the hero's attack, defense, power, knowledge, morale and luck.
+    uint32_t getStatsVersion() const
+    {
+        return _statsVersion;
+    }
+
+    // Must be called on every change of primary or secondary skills, artifacts, visited objects and of the castle the hero stays in
+    void invalidateStats()
+    {
+        ++_statsVersion;
+    }
+
 protected:
     friend StreamBase & operator<<( StreamBase &, const HeroBase & );
     friend StreamBase & operator>>( StreamBase &, HeroBase & );
@@ -132,6 +144,8 @@ protected:
 
     SpellBook spell_book;
     BagArtifacts bag_artifacts;
+
+    uint32_t _statsVersion = 0;
 };
 
 StreamBase & operator<<( StreamBase &, const HeroBase & );
@@ -460,6 +460,9 @@ void Heroes::MeetingDialog( Heroes & otherHero )
             std::set<ArtifactSetData> assembledArtifacts = bag_artifacts.assembleArtifactSetIfPossible();
             const std::set<ArtifactSetData> otherHeroAssembledArtifacts = otherHero.bag_artifacts.assembleArtifactSetIfPossible();
 
+            invalidateStats();
+            otherHero.invalidateStats();
+
             // Use insert instead of std::merge to make appveyour happy
             assembledArtifacts.insert( otherHeroAssembledArtifacts.begin(), otherHeroAssembledArtifacts.end() );
 
@@ -575,6 +578,8 @@ void Heroes::MeetingDialog( Heroes & otherHero )
         }
         else if ( le.MouseClickLeft( moveArtifactsToHero2.area() ) ) {
             moveArtifacts( GetBagArtifacts(), otherHero.GetBagArtifacts() );
+            invalidateStats();
+            otherHero.invalidateStats();
 
             selectArtifacts1.ResetSelected();
             selectArtifacts2.ResetSelected();
@@ -592,6 +597,8 @@ void Heroes::MeetingDialog( Heroes & otherHero )
         }
         else if ( le.MouseClickLeft( moveArtifactsToHero1.area() ) ) {
             moveArtifacts( otherHero.GetBagArtifacts(), GetBagArtifacts() );
+            invalidateStats();
+            otherHero.invalidateStats();
 
             selectArtifacts1.ResetSelected();
             selectArtifacts2.ResetSelected();
@@ -32,6 +32,7 @@ Route::Path::Path( const Heroes & h )
     : hero( &h )
     , dst( -1 )
     , hide( true )
+    , _front( 0 )
 {}
 
 int Route::Path::GetFrontDirection( void ) const
@@ -54,8 +55,16 @@ u32 Route::Path::GetFrontPenalty( void ) const
 
 void Route::Path::PopFront( void )
 {
-    if ( !empty() )
-        pop_front();
+    if ( empty() ) {
+        return;
+    }
+
+    ++_front;
+
+    if ( _front == _steps.size() ) {
+        _steps.clear();
+        _front = 0;
+    }
 }
 
 int32_t Route::Path::GetDestinationIndex( const bool returnLastStep /* = false */ ) const
@@ -67,9 +76,10 @@ int32_t Route::Path::GetDestinationIndex( const bool returnLastStep /* = false *
     return dst;
 }
 
-void Route::Path::setPath( const std::list<Route::Step> & path, int32_t destIndex )
+void Route::Path::setPath( StepList && path, int32_t destIndex )
 {
-    assign( path.begin(), path.end() );
+    _steps = std::move( path );
+    _front = 0;
 
     dst = destIndex;
 }
@@ -81,7 +91,8 @@ void Route::Path::Reset()
     if ( !empty() ) {
         hide = true;
 
-        clear();
+        _steps.clear();
+        _front = 0;
     }
 }
 
@@ -419,7 +430,15 @@ StreamBase & Route::operator<<( StreamBase & msg, const Step & step )
 
 StreamBase & Route::operator<<( StreamBase & msg, const Path & path )
 {
-    return msg << path.dst << path.hide << static_cast<const std::list<Step> &>( path );
+    msg << path.dst << path.hide;
+
+    // Same layout as a list of steps.
+    msg.put32( static_cast<uint32_t>( path.size() ) );
+    for ( const Step & step : path ) {
+        msg << step;
+    }
+
+    return msg;
 }
 
 StreamBase & Route::operator>>( StreamBase & msg, Step & step )
@@ -431,6 +450,6 @@ StreamBase & Route::operator>>( StreamBase & msg, Step & step )
 
 StreamBase & Route::operator>>( StreamBase & msg, Path & path )
 {
-    std::list<Step> & base = path;
-    return msg >> path.dst >> path.hide >> base;
+    path._front = 0;
+    return msg >> path.dst >> path.hide >> path._steps;
 }
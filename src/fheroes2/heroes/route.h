@@ -22,7 +22,8 @@
 #ifndef H2HEROPATH_H
 #define H2HEROPATH_H
 
-#include <list>
+#include <string>
+#include <vector>
 
 #include "direction.h"
 #include "types.h"
@@ -73,9 +74,15 @@ namespace Route
         uint32_t penalty = 0;
     };
 
-    class Path : public std::list<Step>
+    // Steps of a path from its start to its destination.
+    using StepList = std::vector<Step>;
+
+    // Steps are kept in a contiguous array. Passed steps are not removed from the array but skipped so removing the front step is cheap.
+    class Path
     {
     public:
+        using const_iterator = StepList::const_iterator;
+
         explicit Path( const Heroes & );
         Path( const Path & ) = delete;
 
@@ -88,7 +95,37 @@ namespace Route
         int32_t GetDestinationIndex( const bool returnLastStep = false ) const;
         int GetFrontDirection( void ) const;
         u32 GetFrontPenalty( void ) const;
-        void setPath( const std::list<Step> & path, int32_t destIndex );
+        void setPath( StepList && path, int32_t destIndex );
+
+        bool empty() const
+        {
+            return _front == _steps.size();
+        }
+
+        size_t size() const
+        {
+            return _steps.size() - _front;
+        }
+
+        const Step & front() const
+        {
+            return _steps[_front];
+        }
+
+        const Step & back() const
+        {
+            return _steps.back();
+        }
+
+        const_iterator begin() const
+        {
+            return _steps.begin() + static_cast<StepList::difference_type>( _front );
+        }
+
+        const_iterator end() const
+        {
+            return _steps.end();
+        }
 
         void Show( void )
         {
@@ -120,6 +157,9 @@ namespace Route
         const Heroes * hero;
         s32 dst;
         bool hide;
+
+        StepList _steps;
+        size_t _front;
     };
 
     StreamBase & operator<<( StreamBase &, const Step & );
@@ -34,6 +34,7 @@
 #include "game_static.h"
 #include "kingdom.h"
 #include "logging.h"
+#include "parallel.h"
 #include "players.h"
 #include "profit.h"
 #include "race.h"
@@ -158,7 +159,7 @@ void Kingdom::ActionBeforeTurn()
     }
 }
 
-void Kingdom::ActionNewDay( void )
+void Kingdom::ActionNewDay( const Funds & income )
 {
     // countdown of days since the loss of the last town, first day isn't counted
     if ( world.CountDay() > 1 && castles.empty() && lost_town_days > 0 ) {
@@ -177,7 +178,7 @@ void Kingdom::ActionNewDay( void )
     // skip the income for the first day
     if ( world.CountDay() > 1 ) {
         // income
-        AddFundsResource( GetIncome() );
+        AddFundsResource( income );
 
         // handle resource bonus campaign awards
         if ( isControlHuman() && Settings::Get().isCampaignGameType() ) {
@@ -198,7 +199,7 @@ void Kingdom::ActionNewDay( void )
         AddFundsResource( ( *it ).resource );
 
     // remove day visit object
-    visit_object.remove_if( Visit::isDayLife );
+    visit_object.removeIf( Visit::isDayLife );
 }
 
 void Kingdom::ActionNewWeek( void )
@@ -214,7 +215,7 @@ void Kingdom::ActionNewWeek( void )
     }
 
     // remove week visit object
-    visit_object.remove_if( Visit::isWeekLife );
+    visit_object.removeIf( Visit::isWeekLife );
 
     UpdateRecruits();
 }
@@ -222,7 +223,7 @@ void Kingdom::ActionNewWeek( void )
 void Kingdom::ActionNewMonth( void )
 {
     // remove month visit object
-    visit_object.remove_if( Visit::isMonthLife );
+    visit_object.removeIf( Visit::isMonthLife );
 }
 
 void Kingdom::AddHeroes( Heroes * hero )
@@ -363,27 +364,25 @@ bool Kingdom::isVisited( const Maps::Tiles & tile ) const
 
 bool Kingdom::isVisited( s32 index, const MP2::MapObjectType objectType ) const
 {
-    std::list<IndexObject>::const_iterator it = std::find_if( visit_object.begin(), visit_object.end(), [index]( const IndexObject & v ) { return v.isIndex( index ); } );
-    return visit_object.end() != it && ( *it ).isObject( objectType );
+    return visit_object.isLastVisited( index, objectType );
 }
 
 /* return true if object visited */
 bool Kingdom::isVisited( const MP2::MapObjectType objectType ) const
 {
-    return std::any_of( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } );
+    return visit_object.isObjectTypeVisited( objectType );
 }
 
 uint32_t Kingdom::CountVisitedObjects( const MP2::MapObjectType objectType ) const
 {
-    // Safe to downcast as we don't deal with gigantic amount of data.
-    return static_cast<uint32_t>( std::count_if( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } ) );
+    return visit_object.count( objectType );
 }
 
 /* set visited cell */
 void Kingdom::SetVisited( s32 index, const MP2::MapObjectType objectType = MP2::OBJ_ZERO )
 {
     if ( !isVisited( index, objectType ) && objectType != MP2::OBJ_ZERO )
-        visit_object.push_front( IndexObject( index, objectType ) );
+        visit_object.add( index, objectType );
 }
 
 bool Kingdom::isValidKingdomObject( const Maps::Tiles & tile, const MP2::MapObjectType objectType ) const
@@ -757,9 +756,17 @@ Heroes * Kingdom::GetLastBattleWinHero() const
 
 void Kingdoms::NewDay( void )
 {
-    for ( Kingdom & kingdom : kingdoms )
-        if ( kingdom.isPlay() )
-            kingdom.ActionNewDay();
+    // Income of a kingdom depends only on its own castles, heroes and captured objects.
+    std::array<Funds, _size> incomes;
+    fheroes2::parallelFor( _size, [this, &incomes]( const size_t id ) {
+        if ( kingdoms[id].isPlay() ) {
+            incomes[id] = kingdoms[id].GetIncome();
+        }
+    } );
+
+    for ( size_t id = 0; id < _size; ++id )
+        if ( kingdoms[id].isPlay() )
+            kingdoms[id].ActionNewDay( incomes[id] );
 }
 
 void Kingdoms::NewWeek( void )
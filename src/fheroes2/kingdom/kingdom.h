@@ -27,6 +27,7 @@
 #include "mp2.h"
 #include "pairs.h"
 #include "puzzle.h"
+#include "visit.h"
 
 struct CapturedObjects;
 
@@ -135,7 +136,8 @@ public:
     void RemoveCastle( const Castle * );
 
     void ActionBeforeTurn();
-    void ActionNewDay( void );
+    // Daily income is calculated in advance for all kingdoms at once.
+    void ActionNewDay( const Funds & income );
     void ActionNewWeek( void );
     void ActionNewMonth( void );
 
@@ -179,7 +181,7 @@ private:
     Recruits recruits;
     LastLoseHero lost_hero;
 
-    std::list<IndexObject> visit_object;
+    VisitedObjects visit_object;
 
     Puzzle puzzle_maps;
     u32 visited_tents_colors;
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include "ai.h"
 #include "difficulty.h"
@@ -38,12 +39,12 @@
 
 namespace
 {
-    std::vector<int32_t> getTileToClearIndicies( const int32_t tileIndex, int scouteValue, const int playerColor )
+    // Reveal area is a disc so it is processed as [x1; x2] range of every row it covers.
+    template <typename RowFunction>
+    void forEachRevealRow( const int32_t tileIndex, int scouteValue, const int playerColor, RowFunction rowFunction )
     {
-        std::vector<int32_t> indicies;
-
         if ( scouteValue <= 0 || !Maps::isValidAbsIndex( tileIndex ) ) {
-            return indicies;
+            return;
         }
 
         const fheroes2::Point center = Maps::GetPoint( tileIndex );
@@ -55,23 +56,28 @@ namespace
         }
 
         const int revealRadiusSquared = scouteValue * scouteValue + 4; // constant factor for "backwards compatibility"
-        for ( int32_t y = center.y - scouteValue; y <= center.y + scouteValue; ++y ) {
-            if ( y < 0 || y >= world.h() )
-                continue;
+        const int32_t firstRow = std::max( center.y - scouteValue, 0 );
+        const int32_t lastRow = std::min( center.y + scouteValue, world.h() - 1 );
 
-            for ( int32_t x = center.x - scouteValue; x <= center.x + scouteValue; ++x ) {
-                if ( x < 0 || x >= world.w() )
-                    continue;
+        for ( int32_t y = firstRow; y <= lastRow; ++y ) {
+            const int32_t dy = y - center.y;
+            const int32_t maxDxSquared = revealRadiusSquared - dy * dy;
 
-                const int32_t dx = x - center.x;
-                const int32_t dy = y - center.y;
-                if ( revealRadiusSquared >= dx * dx + dy * dy ) {
-                    indicies.emplace_back( Maps::GetIndexFromAbsPoint( x, y ) );
-                }
+            // The largest dx within the disc: dx * dx <= maxDxSquared.
+            int32_t maxDx = std::min( static_cast<int32_t>( std::sqrt( static_cast<double>( maxDxSquared ) ) ), scouteValue );
+            while ( maxDx * maxDx > maxDxSquared ) {
+                --maxDx;
+            }
+            while ( maxDx < scouteValue && ( maxDx + 1 ) * ( maxDx + 1 ) <= maxDxSquared ) {
+                ++maxDx;
             }
-        }
 
-        return indicies;
+            const int32_t x1 = std::max( center.x - maxDx, 0 );
+            const int32_t x2 = std::min( center.x + maxDx, world.w() - 1 );
+            if ( x1 <= x2 ) {
+                rowFunction( y, x1, x2 );
+            }
+        }
     }
 
     Maps::Indexes MapsIndexesFilteredObject( const Maps::Indexes & indexes, const MP2::MapObjectType objectType, const bool ignoreHeroes = true )
@@ -325,14 +331,15 @@ Maps::Indexes Maps::getAroundIndexes( const int32_t tileIndex, const int32_t max
 
 void Maps::ClearFog( const int32_t tileIndex, const int scouteValue, const int playerColor )
 {
-    const std::vector<int32_t> tileIndicies = getTileToClearIndicies( tileIndex, scouteValue, playerColor );
-    if ( tileIndicies.empty() ) {
-        // Nothing to uncover.
-        return;
-    }
-
     const bool isAIPlayer = world.GetKingdom( playerColor ).isControlAI();
     const int alliedColors = Players::GetPlayerFriends( playerColor );
+    const Maps::FogPlanes & fogPlanes = world.getFogPlanes();
+
+    // Only tiles which are still fogged for any allied color are visited.
+    std::vector<int32_t> tileIndicies;
+    forEachRevealRow( tileIndex, scouteValue, playerColor, [&fogPlanes, alliedColors, &tileIndicies]( const int32_t y, const int32_t x1, const int32_t x2 ) {
+        fogPlanes.getFoggedTiles( y, x1, x2, alliedColors, tileIndicies );
+    } );
 
     for ( const int32_t index : tileIndicies ) {
         Maps::Tiles & tile = world.GetTiles( index );
@@ -346,16 +353,12 @@ void Maps::ClearFog( const int32_t tileIndex, const int scouteValue, const int p
 
 int32_t Maps::getFogTileCountToBeRevealed( const int32_t tileIndex, const int scouteValue, const int playerColor )
 {
-    const std::vector<int32_t> tileIndicies = getTileToClearIndicies( tileIndex, scouteValue, playerColor );
+    const Maps::FogPlanes & fogPlanes = world.getFogPlanes();
 
     int32_t tileCount = 0;
-
-    for ( const int32_t index : tileIndicies ) {
-        const Maps::Tiles & tile = world.GetTiles( index );
-        if ( tile.isFog( playerColor ) ) {
-            ++tileCount;
-        }
-    }
+    forEachRevealRow( tileIndex, scouteValue, playerColor, [&fogPlanes, playerColor, &tileCount]( const int32_t y, const int32_t x1, const int32_t x2 ) {
+        tileCount += fogPlanes.countFog( y, x1, x2, playerColor );
+    } );
 
     return tileCount;
 }
@@ -0,0 +1,145 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "maps_fog.h"
+
+#include <cassert>
+#include <cstddef>
+
+namespace
+{
+    int32_t countBits( uint64_t value )
+    {
+        value = value - ( ( value >> 1 ) & 0x5555555555555555ULL );
+        value = ( value & 0x3333333333333333ULL ) + ( ( value >> 2 ) & 0x3333333333333333ULL );
+        value = ( value + ( value >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+        return static_cast<int32_t>( ( value * 0x0101010101010101ULL ) >> 56 );
+    }
+
+    // Returns a mask of bits [first; last] within a word.
+    uint64_t getWordMask( const int32_t first, const int32_t last )
+    {
+        assert( first >= 0 && first <= last && last < 64 );
+
+        const uint64_t upperMask = ( last == 63 ) ? ~0ULL : ( ( 1ULL << ( last + 1 ) ) - 1 );
+        return upperMask & ( ~0ULL << first );
+    }
+}
+
+namespace Maps
+{
+    void FogPlanes::reset( const int32_t width, const int32_t height )
+    {
+        _width = width;
+        _height = height;
+        _wordsPerRow = ( width + 63 ) / 64;
+
+        for ( std::vector<uint64_t> & plane : _planes ) {
+            plane.assign( static_cast<size_t>( _wordsPerRow ) * height, 0 );
+        }
+    }
+
+    void FogPlanes::setFog( const int32_t tileIndex, const int colors )
+    {
+        if ( !_isValidTile( tileIndex ) )
+            return;
+
+        const size_t wordId = static_cast<size_t>( tileIndex / _width ) * _wordsPerRow + ( tileIndex % _width ) / 64;
+        const uint64_t bit = 1ULL << ( ( tileIndex % _width ) % 64 );
+
+        for ( int colorId = 0; colorId < COLOR_COUNT; ++colorId ) {
+            if ( colors & ( 1 << colorId ) ) {
+                _planes[colorId][wordId] |= bit;
+            }
+        }
+    }
+
+    void FogPlanes::clearFog( const int32_t tileIndex, const int colors )
+    {
+        if ( !_isValidTile( tileIndex ) )
+            return;
+
+        const size_t wordId = static_cast<size_t>( tileIndex / _width ) * _wordsPerRow + ( tileIndex % _width ) / 64;
+        const uint64_t bit = 1ULL << ( ( tileIndex % _width ) % 64 );
+
+        for ( int colorId = 0; colorId < COLOR_COUNT; ++colorId ) {
+            if ( colors & ( 1 << colorId ) ) {
+                _planes[colorId][wordId] &= ~bit;
+            }
+        }
+    }
+
+    int32_t FogPlanes::countFog( const int32_t y, const int32_t x1, const int32_t x2, const int colors ) const
+    {
+        assert( y >= 0 && y < _height && x1 >= 0 && x1 <= x2 && x2 < _width );
+
+        if ( ( colors & ( ( 1 << COLOR_COUNT ) - 1 ) ) == 0 ) {
+            // The same as Maps::Tiles::isFog(): no colors means that every tile is fogged.
+            return x2 - x1 + 1;
+        }
+
+        const size_t rowOffset = static_cast<size_t>( y ) * _wordsPerRow;
+        const int32_t firstWord = x1 / 64;
+        const int32_t lastWord = x2 / 64;
+
+        int32_t count = 0;
+
+        for ( int32_t wordId = firstWord; wordId <= lastWord; ++wordId ) {
+            uint64_t word = getWordMask( ( wordId == firstWord ) ? x1 % 64 : 0, ( wordId == lastWord ) ? x2 % 64 : 63 );
+
+            for ( int colorId = 0; colorId < COLOR_COUNT && word != 0; ++colorId ) {
+                if ( colors & ( 1 << colorId ) ) {
+                    word &= _planes[colorId][rowOffset + wordId];
+                }
+            }
+
+            count += countBits( word );
+        }
+
+        return count;
+    }
+
+    void FogPlanes::getFoggedTiles( const int32_t y, const int32_t x1, const int32_t x2, const int colors, std::vector<int32_t> & tileIndexes ) const
+    {
+        assert( y >= 0 && y < _height && x1 >= 0 && x1 <= x2 && x2 < _width );
+
+        const size_t rowOffset = static_cast<size_t>( y ) * _wordsPerRow;
+        const int32_t firstWord = x1 / 64;
+        const int32_t lastWord = x2 / 64;
+
+        for ( int32_t wordId = firstWord; wordId <= lastWord; ++wordId ) {
+            uint64_t word = 0;
+            for ( int colorId = 0; colorId < COLOR_COUNT; ++colorId ) {
+                if ( colors & ( 1 << colorId ) ) {
+                    word |= _planes[colorId][rowOffset + wordId];
+                }
+            }
+
+            word &= getWordMask( ( wordId == firstWord ) ? x1 % 64 : 0, ( wordId == lastWord ) ? x2 % 64 : 63 );
+
+            while ( word != 0 ) {
+                // Position of the lowest set bit.
+                const int32_t bitId = countBits( ( word & ( ~word + 1 ) ) - 1 );
+                tileIndexes.push_back( y * _width + wordId * 64 + bitId );
+                word &= word - 1;
+            }
+        }
+    }
+}
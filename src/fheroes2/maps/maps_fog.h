@@ -0,0 +1,62 @@
+/***************************************************************************
+ *   Free Heroes of Might and Magic II: https://github.com/ihhub/fheroes2  *
+ *   Copyright (C) 2021                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Maps
+{
+    // Fog of war stored as one bit per tile for every player color. Map rows are packed into 64-bit words so fogged tiles within a row range
+    // are counted by popcount and fully revealed areas are skipped a word at a time. Maps::Tiles keeps the fog state as well and remains its primary storage.
+    class FogPlanes
+    {
+    public:
+        // Resizes planes for the given map size. All tiles are considered as revealed.
+        void reset( const int32_t width, const int32_t height );
+
+        void setFog( const int32_t tileIndex, const int colors );
+        void clearFog( const int32_t tileIndex, const int colors );
+
+        // Returns the number of tiles within [x1; x2] range of the row which are fogged for all given colors (like Maps::Tiles::isFog()).
+        int32_t countFog( const int32_t y, const int32_t x1, const int32_t x2, const int colors ) const;
+
+        // Returns indexes of tiles within [x1; x2] range of the row which are fogged for at least one of the given colors.
+        void getFoggedTiles( const int32_t y, const int32_t x1, const int32_t x2, const int colors, std::vector<int32_t> & tileIndexes ) const;
+
+    private:
+        enum : int
+        {
+            COLOR_COUNT = 6
+        };
+
+        int32_t _width = 0;
+        int32_t _height = 0;
+        int32_t _wordsPerRow = 0;
+        std::array<std::vector<uint64_t>, COLOR_COUNT> _planes;
+
+        bool _isValidTile( const int32_t tileIndex ) const
+        {
+            return tileIndex >= 0 && tileIndex < _width * _height;
+        }
+    };
+}
@@ -419,6 +419,64 @@ namespace
 
         return false;
     }
+
+    // Every column of the tile snapshot is a block of little-endian values of the same type.
+    template <typename T, typename Container, typename Getter>
+    void writeColumn( StreamBase & msg, const Container & items, Getter getter )
+    {
+        if ( items.empty() ) {
+            return;
+        }
+
+        std::vector<uint8_t> column;
+        column.reserve( items.size() * sizeof( T ) );
+
+        for ( const auto & item : items ) {
+            const uint64_t value = static_cast<uint64_t>( static_cast<T>( getter( item ) ) );
+            for ( size_t i = 0; i < sizeof( T ); ++i ) {
+                column.push_back( static_cast<uint8_t>( value >> ( 8 * i ) ) );
+            }
+        }
+
+        msg.putRaw( reinterpret_cast<const char *>( column.data() ), column.size() );
+    }
+
+    template <typename T, typename Container, typename Setter>
+    void readColumn( StreamBase & msg, Container & items, Setter setter )
+    {
+        if ( items.empty() ) {
+            return;
+        }
+
+        // A truncated stream gives zero values just like the rest of the stream reads.
+        const std::vector<uint8_t> column = msg.getRaw( items.size() * sizeof( T ) );
+        const uint8_t * data = column.data();
+        for ( auto & item : items ) {
+            uint64_t value = 0;
+            for ( size_t i = 0; i < sizeof( T ); ++i ) {
+                value |= static_cast<uint64_t>( data[i] ) << ( 8 * i );
+            }
+            data += sizeof( T );
+
+            setter( item, static_cast<T>( value ) );
+        }
+    }
+
+    void writeAddonColumns( StreamBase & msg, const std::vector<Maps::TilesAddon> & addons )
+    {
+        writeColumn<uint8_t>( msg, addons, []( const Maps::TilesAddon & addon ) { return addon.level; } );
+        writeColumn<uint32_t>( msg, addons, []( const Maps::TilesAddon & addon ) { return addon.uniq; } );
+        writeColumn<uint8_t>( msg, addons, []( const Maps::TilesAddon & addon ) { return addon.object; } );
+        writeColumn<uint8_t>( msg, addons, []( const Maps::TilesAddon & addon ) { return addon.index; } );
+    }
+
+    void readAddonColumns( StreamBase & msg, std::vector<Maps::TilesAddon> & addons )
+    {
+        readColumn<uint8_t>( msg, addons, []( Maps::TilesAddon & addon, const uint8_t value ) { addon.level = value; } );
+        readColumn<uint32_t>( msg, addons, []( Maps::TilesAddon & addon, const uint32_t value ) { addon.uniq = value; } );
+        readColumn<uint8_t>( msg, addons, []( Maps::TilesAddon & addon, const uint8_t value ) { addon.object = value; } );
+        readColumn<uint8_t>( msg, addons, []( Maps::TilesAddon & addon, const uint8_t value ) { addon.index = value; } );
+    }
 }
 
 Maps::TilesAddon::TilesAddon()
@@ -696,11 +754,81 @@ std::pair<int, int> Maps::Tiles::ColorRaceFromHeroSprite( const uint32_t heroSpr
 }
 
 /* Maps::Addons */
+void Maps::Addons::clear()
+{
+    _heap.clear();
+    _heap.shrink_to_fit();
+    _size = 0;
+}
+
+void Maps::Addons::push_back( const TilesAddon & addon )
+{
+    if ( !_heap.empty() ) {
+        _heap.push_back( addon );
+        return;
+    }
+
+    if ( _size < inlineCapacity ) {
+        _inline[_size] = addon;
+        ++_size;
+        return;
+    }
+
+    _heap.reserve( 2 * inlineCapacity );
+    _heap.assign( _inline.begin(), _inline.end() );
+    _heap.push_back( addon );
+    _size = 0;
+}
+
+void Maps::Addons::push_front( const TilesAddon & addon )
+{
+    push_back( addon );
+    std::rotate( begin(), end() - 1, end() );
+}
+
+void Maps::Addons::pop_back()
+{
+    assert( !empty() );
+    _erase( end() - 1 );
+}
+
+void Maps::Addons::sort( bool ( *predicate )( const TilesAddon &, const TilesAddon & ) )
+{
+    // Tiles have only a few addons so an insertion sort is the fastest stable sort here.
+    iterator first = begin();
+    iterator last = end();
+    if ( first == last ) {
+        return;
+    }
+
+    for ( iterator it = first + 1; it != last; ++it ) {
+        const TilesAddon addon( *it );
+
+        iterator pos = it;
+        while ( pos != first && predicate( addon, *( pos - 1 ) ) ) {
+            *pos = *( pos - 1 );
+            --pos;
+        }
+
+        *pos = addon;
+    }
+}
+
 void Maps::Addons::Remove( u32 uniq )
 {
     remove_if( [uniq]( const TilesAddon & v ) { return v.isUniq( uniq ); } );
 }
 
+void Maps::Addons::_erase( iterator from )
+{
+    if ( _heap.empty() ) {
+        _size = static_cast<uint8_t>( from - _inline.data() );
+    }
+    else {
+        _heap.erase( _heap.begin() + ( from - _heap.data() ), _heap.end() );
+    }
+}
+
 u32 PackTileSpriteIndex( u32 index, u32 shape ) /* index max: 0x3FFF, shape value: 0, 1, 2, 3 */
 {
     return ( shape << 14 ) | ( 0x3FFF & index );
@@ -798,6 +926,8 @@ void Maps::Tiles::SetObject( const MP2::MapObjectType objectType )
 {
     mp2_object = objectType;
     world.resetPathfinder();
+    world.resetRegionPathfinder( _index );
+    world.updateActionObjectTile( _index );
 }
 
 void Maps::Tiles::setBoat( int direction )
@@ -2218,6 +2348,7 @@ std::pair<uint32_t, uint32_t> Maps::Tiles::GetMonsterSpriteIndices( const Tiles
 void Maps::Tiles::ClearFog( int colors )
 {
     fog_colors &= ~colors;
+    world.getFogPlanes().clearFog( _index, colors );
 }
 
 bool Maps::Tiles::isFogAllAround( const int color ) const
@@ -2730,6 +2861,33 @@ StreamBase & Maps::operator>>( StreamBase & msg, TilesAddon & ta )
     return msg;
 }
 
+StreamBase & Maps::operator<<( StreamBase & msg, const Addons & addons )
+{
+    // Same layout as std::list<TilesAddon> used before.
+    msg.put32( static_cast<uint32_t>( addons.size() ) );
+
+    for ( const TilesAddon & addon : addons ) {
+        msg << addon;
+    }
+
+    return msg;
+}
+
+StreamBase & Maps::operator>>( StreamBase & msg, Addons & addons )
+{
+    const uint32_t size = msg.get32();
+
+    addons.clear();
+
+    for ( uint32_t i = 0; i < size; ++i ) {
+        TilesAddon addon;
+        msg >> addon;
+        addons.push_back( addon );
+    }
+
+    return msg;
+}
+
 StreamBase & Maps::operator<<( StreamBase & msg, const Tiles & tile )
 {
     return msg << tile._index << tile.pack_sprite_index << tile.tilePassable << tile.uniq << tile.objectTileset << tile.objectIndex << tile.mp2_object << tile.fog_colors
@@ -2743,3 +2901,91 @@ StreamBase & Maps::operator>>( StreamBase & msg, Tiles & tile )
 
     return msg;
 }
+
+void Maps::writeTiles( StreamBase & msg, const std::vector<Tiles> & tiles )
+{
+    msg.put32( static_cast<uint32_t>( tiles.size() ) );
+
+    // Tile index is the position of the tile in the world so it is not saved.
+    writeColumn<uint16_t>( msg, tiles, []( const Tiles & tile ) { return tile.pack_sprite_index; } );
+    writeColumn<uint16_t>( msg, tiles, []( const Tiles & tile ) { return tile.tilePassable; } );
+    writeColumn<uint32_t>( msg, tiles, []( const Tiles & tile ) { return tile.uniq; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.objectTileset; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.objectIndex; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.mp2_object; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.fog_colors; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.quantity1; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.quantity2; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.quantity3; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.heroID; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile.tileIsRoad; } );
+    writeColumn<uint8_t>( msg, tiles, []( const Tiles & tile ) { return tile._level; } );
+
+    // Addons of each level: the number of addons of every tile and then all addons of all tiles.
+    writeColumn<uint16_t>( msg, tiles, []( const Tiles & tile ) { return tile.addons_level1.size(); } );
+    writeColumn<uint16_t>( msg, tiles, []( const Tiles & tile ) { return tile.addons_level2.size(); } );
+
+    std::vector<TilesAddon> addons;
+    for ( const Tiles & tile : tiles ) {
+        addons.insert( addons.end(), tile.addons_level1.begin(), tile.addons_level1.end() );
+    }
+    msg.put32( static_cast<uint32_t>( addons.size() ) );
+    writeAddonColumns( msg, addons );
+
+    addons.clear();
+    for ( const Tiles & tile : tiles ) {
+        addons.insert( addons.end(), tile.addons_level2.begin(), tile.addons_level2.end() );
+    }
+    msg.put32( static_cast<uint32_t>( addons.size() ) );
+    writeAddonColumns( msg, addons );
+}
+
+void Maps::readTiles( StreamBase & msg, std::vector<Tiles> & tiles )
+{
+    tiles.clear();
+    tiles.resize( msg.get32() );
+
+    for ( size_t i = 0; i < tiles.size(); ++i ) {
+        tiles[i]._index = static_cast<int32_t>( i );
+    }
+
+    readColumn<uint16_t>( msg, tiles, []( Tiles & tile, const uint16_t value ) { tile.pack_sprite_index = value; } );
+    readColumn<uint16_t>( msg, tiles, []( Tiles & tile, const uint16_t value ) { tile.tilePassable = value; } );
+    readColumn<uint32_t>( msg, tiles, []( Tiles & tile, const uint32_t value ) { tile.uniq = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.objectTileset = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.objectIndex = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.mp2_object = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.fog_colors = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.quantity1 = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.quantity2 = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.quantity3 = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.heroID = value; } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile.tileIsRoad = ( value != 0 ); } );
+    readColumn<uint8_t>( msg, tiles, []( Tiles & tile, const uint8_t value ) { tile._level = value; } );
+
+    std::vector<uint16_t> level1Counts( tiles.size(), 0 );
+    std::vector<uint16_t> level2Counts( tiles.size(), 0 );
+    readColumn<uint16_t>( msg, level1Counts, []( uint16_t & count, const uint16_t value ) { count = value; } );
+    readColumn<uint16_t>( msg, level2Counts, []( uint16_t & count, const uint16_t value ) { count = value; } );
+
+    const auto readAddons = [&msg, &tiles]( const std::vector<uint16_t> & counts, Addons Tiles::*level ) {
+        std::vector<TilesAddon> addons( msg.get32() );
+        readAddonColumns( msg, addons );
+
+        size_t offset = 0;
+        for ( size_t i = 0; i < tiles.size(); ++i ) {
+            if ( offset + counts[i] > addons.size() ) {
+                ERROR_LOG( "Tile addons are corrupted." )
+                return;
+            }
+
+            Addons & tileAddons = tiles[i].*level;
+            for ( size_t end = offset + counts[i]; offset < end; ++offset ) {
+                tileAddons.push_back( addons[offset] );
+            }
+        }
+    };
+
+    readAddons( level1Counts, &Tiles::addons_level1 );
+    readAddons( level2Counts, &Tiles::addons_level2 );
+}
@@ -22,7 +22,13 @@
 #ifndef H2TILES_H
 #define H2TILES_H
 
-#include <list>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
 
 #include "army_troop.h"
 #include "artifact.h"
@@ -66,7 +72,7 @@ namespace Maps
 
         ~TilesAddon() = default;
 
-        TilesAddon & operator=( const TilesAddon & ta ) = delete;
+        TilesAddon & operator=( const TilesAddon & ta ) = default;
 
         bool isUniq( const uint32_t id ) const
         {
@@ -92,9 +98,110 @@ namespace Maps
         uint8_t index;
     };
 
-    struct Addons : public std::list<TilesAddon>
+    // Addons of a tile. Up to inlineCapacity addons are stored inside the tile itself so the tile array of the world is a contiguous
+    // pool of addons and the usual edits never allocate. Tiles with more addons move all of them into a heap buffer.
+    class Addons
     {
+    public:
+        using iterator = TilesAddon *;
+        using const_iterator = const TilesAddon *;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        enum : uint8_t
+        {
+            inlineCapacity = 4
+        };
+
+        iterator begin()
+        {
+            return _heap.empty() ? _inline.data() : _heap.data();
+        }
+
+        iterator end()
+        {
+            return begin() + size();
+        }
+
+        const_iterator begin() const
+        {
+            return _heap.empty() ? _inline.data() : _heap.data();
+        }
+
+        const_iterator end() const
+        {
+            return begin() + size();
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator( end() );
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator( begin() );
+        }
+
+        size_t size() const
+        {
+            return _heap.empty() ? _size : _heap.size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        TilesAddon & back()
+        {
+            assert( !empty() );
+            return *( end() - 1 );
+        }
+
+        const TilesAddon & back() const
+        {
+            assert( !empty() );
+            return *( end() - 1 );
+        }
+
+        void clear();
+
+        void push_back( const TilesAddon & addon );
+        void push_front( const TilesAddon & addon );
+        void pop_back();
+
+        template <typename... Args>
+        void emplace_back( Args &&... args )
+        {
+            push_back( TilesAddon( std::forward<Args>( args )... ) );
+        }
+
+        template <typename... Args>
+        void emplace_front( Args &&... args )
+        {
+            push_front( TilesAddon( std::forward<Args>( args )... ) );
+        }
+
+        // Stable sort as std::list::sort used for addons before.
+        void sort( bool ( *predicate )( const TilesAddon &, const TilesAddon & ) );
+
+        template <typename Predicate>
+        void remove_if( Predicate predicate )
+        {
+            _erase( std::remove_if( begin(), end(), predicate ) );
+        }
+
         void Remove( u32 uniq );
+
+    private:
+        std::array<TilesAddon, inlineCapacity> _inline;
+        std::vector<TilesAddon> _heap;
+
+        // Number of inline addons. It is always 0 when the heap buffer is used.
+        uint8_t _size = 0;
+
+        // Removes all addons starting from the given position.
+        void _erase( iterator from );
     };
 
     class Tiles
@@ -239,6 +346,11 @@ namespace Maps
             return ( fog_colors & colors ) == colors;
         }
 
+        int getFogColors() const
+        {
+            return fog_colors;
+        }
+
         bool isFogAllAround( const int color ) const;
         void ClearFog( int color );
 
@@ -340,6 +452,9 @@ namespace Maps
         friend StreamBase & operator<<( StreamBase &, const Tiles & );
         friend StreamBase & operator>>( StreamBase &, Tiles & );
 
+        friend void writeTiles( StreamBase & msg, const std::vector<Tiles> & tiles );
+        friend void readTiles( StreamBase & msg, std::vector<Tiles> & tiles );
+
         friend bool operator<( const Tiles & l, const Tiles & r )
         {
             return l.GetIndex() < r.GetIndex();
@@ -372,9 +487,16 @@ namespace Maps
     };
 
     StreamBase & operator<<( StreamBase &, const TilesAddon & );
+    StreamBase & operator<<( StreamBase &, const Addons & );
+    StreamBase & operator>>( StreamBase &, Addons & );
     StreamBase & operator<<( StreamBase &, const Tiles & );
     StreamBase & operator>>( StreamBase &, TilesAddon & );
     StreamBase & operator>>( StreamBase &, Tiles & );
+
+    // Tiles are saved column by column: all values of one field go as a single little-endian block followed by the next field.
+    // Such blocks are written and read at once and compress better than tiles saved field by field.
+    void writeTiles( StreamBase & msg, const std::vector<Tiles> & tiles );
+    void readTiles( StreamBase & msg, std::vector<Tiles> & tiles );
 }
 
 #endif
@@ -20,8 +20,11 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cassert>
+
+#include "serialize.h"
 #include "visit.h"
-#include "pairs.h"
 
 bool Visit::isDayLife( const IndexObject & visit )
 {
@@ -42,3 +45,136 @@ bool Visit::isBattleLife( const IndexObject & visit )
 {
     return MP2::isBattleLife( static_cast<MP2::MapObjectType>( visit.second ) );
 }
+
+VisitedObjects::VisitedObjects()
+{
+    _objectTypeCounts.fill( 0 );
+}
+
+void VisitedObjects::add( const int32_t index, const int objectType )
+{
+    _objects.emplace_back( index, objectType );
+    _index( _objects.back() );
+}
+
+void VisitedObjects::remove( const int32_t index, const int objectType )
+{
+    if ( !isVisited( index, objectType ) ) {
+        return;
+    }
+
+    _objects.erase( std::remove( _objects.begin(), _objects.end(), IndexObject( index, objectType ) ), _objects.end() );
+    _rebuildIndex();
+}
+
+void VisitedObjects::removeIf( bool ( *predicate )( const IndexObject & ) )
+{
+    const std::vector<IndexObject>::iterator newEnd = std::remove_if( _objects.begin(), _objects.end(), predicate );
+    if ( newEnd == _objects.end() ) {
+        return;
+    }
+
+    _objects.erase( newEnd, _objects.end() );
+    _rebuildIndex();
+}
+
+void VisitedObjects::clear()
+{
+    _objects.clear();
+    _rebuildIndex();
+}
+
+bool VisitedObjects::isVisited( const int32_t index, const int objectType ) const
+{
+    const std::vector<int> * objectTypes = _getObjectTypes( index );
+    return objectTypes != nullptr && std::find( objectTypes->begin(), objectTypes->end(), objectType ) != objectTypes->end();
+}
+
+bool VisitedObjects::isLastVisited( const int32_t index, const int objectType ) const
+{
+    const std::vector<int> * objectTypes = _getObjectTypes( index );
+    return objectTypes != nullptr && objectTypes->back() == objectType;
+}
+
+uint32_t VisitedObjects::count( const int objectType ) const
+{
+    if ( objectType < 0 || static_cast<size_t>( objectType ) >= _objectTypeCounts.size() ) {
+        return 0;
+    }
+
+    return _objectTypeCounts[objectType];
+}
+
+const std::vector<int> * VisitedObjects::_getObjectTypes( const int32_t index ) const
+{
+    // Negative indexes are not a part of the bitset and are looked up directly.
+    if ( index >= 0 && ( static_cast<size_t>( index ) >= _visitedIndexes.size() || !_visitedIndexes[index] ) ) {
+        return nullptr;
+    }
+
+    const std::unordered_map<int32_t, std::vector<int>>::const_iterator it = _objectTypesByIndex.find( index );
+    if ( it == _objectTypesByIndex.end() ) {
+        return nullptr;
+    }
+
+    assert( !it->second.empty() );
+    return &it->second;
+}
+
+void VisitedObjects::_index( const IndexObject & object )
+{
+    if ( object.first >= 0 ) {
+        if ( static_cast<size_t>( object.first ) >= _visitedIndexes.size() ) {
+            _visitedIndexes.resize( static_cast<size_t>( object.first ) + 1, false );
+        }
+
+        _visitedIndexes[object.first] = true;
+    }
+
+    _objectTypesByIndex[object.first].push_back( object.second );
+
+    if ( object.second >= 0 && static_cast<size_t>( object.second ) < _objectTypeCounts.size() ) {
+        ++_objectTypeCounts[object.second];
+    }
+}
+
+void VisitedObjects::_rebuildIndex()
+{
+    std::fill( _visitedIndexes.begin(), _visitedIndexes.end(), false );
+    _objectTypesByIndex.clear();
+    _objectTypeCounts.fill( 0 );
+
+    for ( const IndexObject & object : _objects ) {
+        _index( object );
+    }
+}
+
+StreamBase & operator<<( StreamBase & msg, const VisitedObjects & visited )
+{
+    // Same layout as std::list<IndexObject> where the most recently visited object was the first one.
+    msg.put32( static_cast<uint32_t>( visited._objects.size() ) );
+    for ( std::vector<IndexObject>::const_reverse_iterator it = visited._objects.rbegin(); it != visited._objects.rend(); ++it ) {
+        msg << *it;
+    }
+
+    return msg;
+}
+
+StreamBase & operator>>( StreamBase & msg, VisitedObjects & visited )
+{
+    const uint32_t size = msg.get32();
+
+    visited._objects.clear();
+    visited._objects.reserve( size );
+
+    for ( uint32_t i = 0; i < size; ++i ) {
+        IndexObject object;
+        msg >> object;
+        visited._objects.push_back( object );
+    }
+
+    std::reverse( visited._objects.begin(), visited._objects.end() );
+    visited._rebuildIndex();
+
+    return msg;
+}
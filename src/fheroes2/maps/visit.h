@@ -23,7 +23,14 @@
 #ifndef H2MAPSVISIT_H
 #define H2MAPSVISIT_H
 
-class IndexObject;
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "pairs.h"
+
+class StreamBase;
 
 namespace Visit
 {
@@ -39,4 +46,70 @@ namespace Visit
     bool isBattleLife( const IndexObject & visit );
 }
 
+// Visited objects of a hero or a kingdom. Objects are stored in visiting order while a bitset over indexes, per index object lists
+// and per object type counters make all queries constant time. The serialized form is the same as of std::list<IndexObject>
+// with the most recently visited object first.
+class VisitedObjects
+{
+public:
+    VisitedObjects();
+
+    // Adds the object as the most recently visited one.
+    void add( const int32_t index, const int objectType );
+
+    // Removes all entries of the object at the given index.
+    void remove( const int32_t index, const int objectType );
+
+    void removeIf( bool ( *predicate )( const IndexObject & ) );
+
+    void clear();
+
+    bool empty() const
+    {
+        return _objects.empty();
+    }
+
+    // Returns true if the object was visited at the given index.
+    bool isVisited( const int32_t index, const int objectType ) const;
+
+    // Returns true if the object is the most recently visited one at the given index.
+    bool isLastVisited( const int32_t index, const int objectType ) const;
+
+    bool isObjectTypeVisited( const int objectType ) const
+    {
+        return count( objectType ) > 0;
+    }
+
+    uint32_t count( const int objectType ) const;
+
+    // Objects in visiting order, the most recently visited object is the last one.
+    const std::vector<IndexObject> & objects() const
+    {
+        return _objects;
+    }
+
+private:
+    friend StreamBase & operator<<( StreamBase &, const VisitedObjects & );
+    friend StreamBase & operator>>( StreamBase &, VisitedObjects & );
+
+    std::vector<IndexObject> _objects;
+
+    // Set bits mark indexes which have at least one visited object so most of queries end here.
+    std::vector<bool> _visitedIndexes;
+
+    // Object types visited at every index in visiting order.
+    std::unordered_map<int32_t, std::vector<int>> _objectTypesByIndex;
+
+    std::array<uint32_t, 256> _objectTypeCounts;
+
+    const std::vector<int> * _getObjectTypes( const int32_t index ) const;
+
+    void _index( const IndexObject & object );
+
+    void _rebuildIndex();
+};
+
+StreamBase & operator<<( StreamBase &, const VisitedObjects & );
+StreamBase & operator>>( StreamBase &, VisitedObjects & );
+
 #endif
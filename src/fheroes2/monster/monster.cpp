@@ -788,14 +788,16 @@ Monster Monster::Rand( const LevelType type )
 {
     if ( type == LevelType::LEVEL_ANY )
         return Monster( Rand::Get( PEASANT, WATER_ELEMENT ) );
-    static std::vector<Monster> monstersVec[static_cast<int>( LevelType::LEVEL_4 )];
-    if ( monstersVec[0].empty() ) {
+    // Game sessions on different threads share the list so it is filled by the thread-safe initialization of the static variable
+    static const std::vector<std::vector<Monster>> monstersVec = []() {
+        std::vector<std::vector<Monster>> monsters( static_cast<int>( LevelType::LEVEL_4 ) );
         for ( uint32_t i = PEASANT; i <= WATER_ELEMENT; ++i ) {
             const Monster monster( i );
             if ( monster.GetRandomUnitLevel() > LevelType::LEVEL_ANY )
-                monstersVec[static_cast<int>( monster.GetRandomUnitLevel() ) - 1].push_back( monster );
+                monsters[static_cast<int>( monster.GetRandomUnitLevel() ) - 1].push_back( monster );
         }
-    }
+        return monsters;
+    }();
     return Rand::Get( monstersVec[static_cast<int>( type ) - 1] );
 }
 
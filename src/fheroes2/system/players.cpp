@@ -35,10 +35,6 @@
 
 namespace
 {
-    const int playersSize = KINGDOMMAX + 1;
-    Player * _players[playersSize] = { nullptr };
-    int human_colors = 0;
-
     enum
     {
         ST_INGAME = 0x2000
@@ -239,6 +235,8 @@ StreamBase & operator>>( StreamBase & msg, Player & player )
 
 Players::Players()
     : current_color( 0 )
+    , _playerByColor()
+    , _humanColors( 0 )
 {
     reserve( KINGDOMMAX );
 }
@@ -255,11 +253,10 @@ void Players::clear( void )
 
     std::vector<Player *>::clear();
 
-    for ( u32 ii = 0; ii < KINGDOMMAX + 1; ++ii )
-        _players[ii] = nullptr;
+    _playerByColor.fill( nullptr );
 
     current_color = 0;
-    human_colors = 0;
+    _humanColors = 0;
 }
 
 void Players::Init( int colors )
@@ -270,7 +267,7 @@ void Players::Init( int colors )
 
     for ( Colors::const_iterator it = vcolors.begin(); it != vcolors.end(); ++it ) {
         push_back( new Player( *it ) );
-        _players[Color::GetIndex( *it )] = back();
+        _playerByColor[Color::GetIndex( *it )] = back();
     }
 
     DEBUG_LOG( DBG_GAME, DBG_INFO, "Players: " << String() );
@@ -299,7 +296,7 @@ void Players::Init( const Maps::FileInfo & fi )
                 first = player;
 
             push_back( player );
-            _players[Color::GetIndex( *it )] = back();
+            _playerByColor[Color::GetIndex( *it )] = back();
         }
 
         if ( first )
@@ -316,13 +313,13 @@ void Players::Init( const Maps::FileInfo & fi )
 
 void Players::Set( const int color, Player * player )
 {
-    assert( color >= 0 && color < playersSize );
-    _players[color] = player;
+    assert( color >= 0 && color < static_cast<int>( _playerByColor.size() ) );
+    _playerByColor[color] = player;
 }
 
 Player * Players::Get( int color )
 {
-    return _players[Color::GetIndex( color )];
+    return Settings::Get().GetPlayers()._playerByColor[Color::GetIndex( color )];
 }
 
 bool Players::isFriends( int player, int colors )
@@ -420,16 +417,17 @@ void Players::SetStartGame( void )
     for_each( begin(), end(), []( Player * player ) { PlayerFixMultiControl( player ); } );
 
     current_color = Color::NONE;
-    human_colors = Color::NONE;
+    _humanColors = Color::NONE;
 
     DEBUG_LOG( DBG_GAME, DBG_INFO, String() );
 }
 
 int Players::HumanColors( void )
 {
-    if ( 0 == human_colors )
-        human_colors = Settings::Get().GetPlayers().GetColors( CONTROL_HUMAN, true );
-    return human_colors;
+    Players & players = Settings::Get().GetPlayers();
+    if ( 0 == players._humanColors )
+        players._humanColors = players.GetColors( CONTROL_HUMAN, true );
+    return players._humanColors;
 }
 
 int Players::FriendColors( void )
@@ -508,7 +506,7 @@ StreamBase & operator>>( StreamBase & msg, Players & players )
     for ( u32 ii = 0; ii < vcolors.size(); ++ii ) {
         Player * player = new Player();
         msg >> *player;
-        Players::Set( Color::GetIndex( player->GetColor() ), player );
+        players.Set( Color::GetIndex( player->GetColor() ), player );
         players.push_back( player );
     }
 
@@ -23,12 +23,14 @@
 #ifndef H2PLAYERS_H
 #define H2PLAYERS_H
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "bitmodes.h"
 #include "color.h"
+#include "gamedefs.h"
 
 namespace Maps
 {
@@ -185,7 +187,9 @@ public:
     Player * GetCurrent( void );
     const Player * GetCurrent( void ) const;
 
-    static void Set( const int color, Player * player );
+    void Set( const int color, Player * player );
+
+    // Static functions refer to the players of the current game session
     static Player * Get( int color );
     static int GetPlayerControl( int color );
     static int GetPlayerRace( int color );
@@ -199,6 +203,11 @@ public:
     static int FriendColors( void );
 
     int current_color;
+
+private:
+    // Players indexed by color index
+    std::array<Player *, KINGDOMMAX + 1> _playerByColor;
+    int _humanColors;
 };
 
 StreamBase & operator<<( StreamBase &, const Players & );
@@ -23,6 +23,8 @@
 enum SaveFileFormat
 {
     // TODO: if you're adding a new version you must assign it to CURRENT_FORMAT_VERSION located at the bottom.
+    FORMAT_VERSION_PRE2_098_RELEASE = 9703,
+    FORMAT_VERSION_PRE1_098_RELEASE = 9702,
     FORMAT_VERSION_097_RELEASE = 9701,
     FORMAT_VERSION_PRE_097_RELEASE = 9700,
     FORMAT_VERSION_096_RELEASE = 9600,
@@ -30,5 +32,5 @@ enum SaveFileFormat
 
     LAST_SUPPORTED_FORMAT_VERSION = FORMAT_VERSION_095_RELEASE,
 
-    CURRENT_FORMAT_VERSION = FORMAT_VERSION_097_RELEASE
+    CURRENT_FORMAT_VERSION = FORMAT_VERSION_PRE2_098_RELEASE
 };
@@ -26,6 +26,7 @@
 
 #include "difficulty.h"
 #include "game.h"
+#include "game_session.h"
 #include "logging.h"
 #include "save_format_version.h"
 #include "screen.h"
@@ -50,7 +51,7 @@ namespace
         GLOBAL_PRICELOYALTY = 0x00000004,
 
         GLOBAL_RENDER_VSYNC = 0x00000008,
-        // UNUSED = 0x00000010,
+        GLOBAL_PRELOAD_RESOURCES = 0x00000010,
         // UNUSED = 0x00000020,
 
         GLOBAL_SHOWCPANEL = 0x00000040,
@@ -88,10 +89,13 @@ Settings::Settings()
     : debug( 0 )
     , video_mode( fheroes2::Size( fheroes2::Display::DEFAULT_WIDTH, fheroes2::Display::DEFAULT_HEIGHT ) )
     , game_difficulty( Difficulty::NORMAL )
+    , _isAIActionLogReplay( false )
     , sound_volume( 6 )
     , music_volume( 6 )
     , _musicType( MUSIC_EXTERNAL )
     , _controllerPointerSpeed( 10 )
+    , _imageCacheLimit( 0 )
+    , _soundCacheLimit( 64 )
     , heroes_speed( DEFAULT_SPEED_DELAY )
     , ai_speed( DEFAULT_SPEED_DELAY )
     , scroll_speed( SCROLL_NORMAL )
@@ -116,17 +120,9 @@ Settings::Settings()
     EnablePriceOfLoyaltySupport( false );
 }
 
-Settings::~Settings()
-{
-    if ( !LoadedGameVersion() )
-        BinarySave();
-}
-
 Settings & Settings::Get()
 {
-    static Settings conf;
-
-    return conf;
+    return Game::Session::Get().getSettings();
 }
 
 bool Settings::Read( const std::string & filename )
@@ -296,6 +292,14 @@ bool Settings::Read( const std::string & filename )
         _controllerPointerSpeed = clamp( config.IntParams( "controller pointer speed" ), 0, 100 );
     }
 
+    if ( config.Exists( "image cache limit" ) ) {
+        _imageCacheLimit = std::max( config.IntParams( "image cache limit" ), 0 );
+    }
+
+    if ( config.Exists( "sound cache limit" ) ) {
+        _soundCacheLimit = std::max( config.IntParams( "sound cache limit" ), 0 );
+    }
+
     if ( config.Exists( "first time game run" ) && config.StrParams( "first time game run" ) == "off" ) {
         resetFirstGameRun();
     }
@@ -318,6 +322,15 @@ bool Settings::Read( const std::string & filename )
         }
     }
 
+    if ( config.Exists( "preload resources" ) ) {
+        if ( config.StrParams( "preload resources" ) == "on" ) {
+            opt_global.SetModes( GLOBAL_PRELOAD_RESOURCES );
+        }
+        else {
+            opt_global.ResetModes( GLOBAL_PRELOAD_RESOURCES );
+        }
+    }
+
     BinaryLoad();
 
     if ( video_mode.width > 0 && video_mode.height > 0 ) {
@@ -428,6 +441,12 @@ std::string Settings::String() const
     os << std::endl << "# controller pointer speed: 0 - 100" << std::endl;
     os << "controller pointer speed = " << _controllerPointerSpeed << std::endl;
 
+    os << std::endl << "# memory limit for decoded images in megabytes (0 means no limit)" << std::endl;
+    os << "image cache limit = " << _imageCacheLimit << std::endl;
+
+    os << std::endl << "# memory limit for decoded sounds and music in megabytes (0 means no limit)" << std::endl;
+    os << "sound cache limit = " << _soundCacheLimit << std::endl;
+
     os << std::endl << "# first time game run (show additional hints): on/off" << std::endl;
     os << "first time game run = " << ( opt_global.Modes( GLOBAL_FIRST_RUN ) ? "on" : "off" ) << std::endl;
 
@@ -437,6 +456,9 @@ std::string Settings::String() const
     os << std::endl << "# enable V-Sync (Vertical Synchronization) for rendering" << std::endl;
     os << "v-sync = " << ( opt_global.Modes( GLOBAL_RENDER_VSYNC ) ? "on" : "off" ) << std::endl;
 
+    os << std::endl << "# decode commonly used images at startup using all CPU cores: on/off" << std::endl;
+    os << "preload resources = " << ( opt_global.Modes( GLOBAL_PRELOAD_RESOURCES ) ? "on" : "off" ) << std::endl;
+
     return os.str();
 }
 
@@ -728,6 +750,12 @@ void Settings::SetDebug( int d )
     Logging::SetDebugLevel( debug );
 }
 
+void Settings::setAIActionLog( const std::string & fileName, const bool replay )
+{
+    _aiActionLogFile = fileName;
+    _isAIActionLogReplay = replay;
+}
+
 void Settings::SetGameDifficulty( int d )
 {
     game_difficulty = d;
@@ -1284,6 +1312,11 @@ bool Settings::isVSyncEnabled() const
     return opt_global.Modes( GLOBAL_RENDER_VSYNC );
 }
 
+bool Settings::isResourcePreloadEnabled() const
+{
+    return opt_global.Modes( GLOBAL_PRELOAD_RESOURCES );
+}
+
 bool Settings::isFirstGameRun() const
 {
     return opt_global.Modes( GLOBAL_FIRST_RUN );
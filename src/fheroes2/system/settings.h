@@ -28,6 +28,11 @@
 #include "maps_fileinfo.h"
 #include "players.h"
 
+namespace Game
+{
+    class Session;
+}
+
 enum : int
 {
     SCROLL_SLOW = 1,
@@ -106,6 +111,9 @@ public:
 
     Settings & operator=( const Settings & ) = delete;
 
+    ~Settings() = default;
+
+    // Returns the settings of the game session of the calling thread.
     static Settings & Get();
 
     bool Read( const std::string & );
@@ -128,6 +136,17 @@ public:
     const std::string & getGameLanguage() const;
     const std::string & loadedFileLanguage() const;
 
+    // AI action log given on the command line: the file is written during the game or replayed if isAIActionLogReplay() is true.
+    const std::string & getAIActionLogFile() const
+    {
+        return _aiActionLogFile;
+    }
+
+    bool isAIActionLogReplay() const
+    {
+        return _isAIActionLogReplay;
+    }
+
     const fheroes2::Point & PosRadar() const;
     const fheroes2::Point & PosButtons() const;
     const fheroes2::Point & PosIcons() const;
@@ -155,6 +174,7 @@ public:
     bool isShowIntro() const;
 
     bool isVSyncEnabled() const;
+    bool isResourcePreloadEnabled() const;
 
     bool isFirstGameRun() const;
     void resetFirstGameRun();
@@ -229,6 +249,8 @@ public:
 
     bool setGameLanguage( const std::string & language );
 
+    void setAIActionLog( const std::string & fileName, const bool replay );
+
     int SoundVolume() const
     {
         return sound_volume;
@@ -305,6 +327,17 @@ public:
     u32 LossCountDays() const;
     int controllerPointerSpeed() const;
 
+    // Memory limits for decoded resources in megabytes. 0 means no limit.
+    int imageCacheLimit() const
+    {
+        return _imageCacheLimit;
+    }
+
+    int soundCacheLimit() const
+    {
+        return _soundCacheLimit;
+    }
+
     void SetMapsFile( const std::string & file );
 
     std::string GetProgramPath() const
@@ -326,9 +359,9 @@ protected:
 private:
     friend StreamBase & operator<<( StreamBase &, const Settings & );
     friend StreamBase & operator>>( StreamBase &, Settings & );
+    friend class Game::Session;
 
     Settings();
-    ~Settings();
 
     BitModes opt_global;
     BitModes opt_game;
@@ -345,12 +378,18 @@ private:
     std::string _gameLanguage;
     std::string _loadedFileLanguage; // not a part of save or configuration file
 
+    // not a part of save or configuration file
+    std::string _aiActionLogFile;
+    bool _isAIActionLogReplay;
+
     Maps::FileInfo current_maps_file;
 
     int sound_volume;
     int music_volume;
     MusicSource _musicType;
     int _controllerPointerSpeed;
+    int _imageCacheLimit;
+    int _soundCacheLimit;
     int heroes_speed;
     int ai_speed;
     int scroll_speed;
@@ -31,6 +31,7 @@
 #include "castle.h"
 #include "game.h"
 #include "game_over.h"
+#include "game_session.h"
 #include "ground.h"
 #include "heroes.h"
 #include "logging.h"
@@ -38,6 +39,7 @@
 #include "maps_objects.h"
 #include "mp2.h"
 #include "pairs.h"
+#include "parallel.h"
 #include "race.h"
 #include "resource.h"
 #include "save_format_version.h"
@@ -125,11 +127,12 @@ namespace
 
         return count;
     }
-}
 
-namespace GameStatic
-{
-    extern u32 uniq;
+    bool isActionObjectTile( const Maps::Tiles & tile )
+    {
+        const MP2::MapObjectType objectType = tile.GetObject();
+        return MP2::isActionObject( objectType ) || objectType == MP2::OBJ_COAST;
+    }
 }
 
 ListActions::~ListActions()
@@ -319,13 +322,11 @@ void CapturedObjects::tributeCapturedObjects( const int playerColorId, const int
     }
 }
 
-World & world = World::Get();
+thread_local World & world = World::Get();
 
 World & World::Get( void )
 {
-    static World insideWorld;
-
-    return insideWorld;
+    return Game::Session::Get().getWorld();
 }
 
 void World::Defaults( void )
@@ -336,6 +337,7 @@ void World::Defaults( void )
     // Map seed is random and persisted on saves
     // this has to be generated before initializing heroes, as campaign-specific heroes start at a higher level and thus have to simulate level ups
     _seed = Rand::Get( std::numeric_limits<uint32_t>::max() );
+    _randomContext.Reset( _seed );
 
     week_next = Week::RandomWeek( *this, false, _weekSeed );
 
@@ -352,6 +354,11 @@ void World::Reset( void )
 
     // maps tiles
     vec_tiles.clear();
+    _fogPlanes.reset( 0, 0 );
+    _actionObjectTiles.clear();
+    _isActionObjectTile.clear();
+    _regionObjectSummaries.clear();
+    _regionObjectFingerprints.clear();
 
     // kingdoms
     vec_kingdoms.clear();
@@ -386,6 +393,7 @@ void World::Reset( void )
     heroes_cond_loss = Heroes::UNKNOWN;
 
     _seed = 0;
+    _randomContext.Reset( _seed );
 }
 
 /* new maps */
@@ -432,6 +440,8 @@ void World::NewMaps( int32_t sw, int32_t sh )
 
         vec_tiles[i].Init( static_cast<int32_t>( i ), mp2tile );
     }
+
+    resetFogPlanes();
 }
 
 void World::InitKingdoms( void )
@@ -653,8 +663,12 @@ void World::NewDay( void )
     if ( BeginWeek() ) {
         NewWeek();
 
+        // castles use their own random stream to not repeat the one used for map objects
+        size_t castleSeed = _weekSeed;
+        fheroes2::hashCombine( castleSeed, static_cast<int>( MP2::OBJ_CASTLE ) );
+
         vec_kingdoms.NewWeek();
-        vec_castles.NewWeek();
+        vec_castles.NewWeek( castleSeed );
         vec_heroes.NewWeek();
     }
 
@@ -684,11 +698,17 @@ void World::NewWeek( void )
 
     // update objects
     if ( week > 1 ) {
-        for ( Maps::Tiles & tile : vec_tiles ) {
-            if ( MP2::isWeekLife( ( tile ).GetObject( false ) ) || tile.GetObject() == MP2::OBJ_MONSTER ) {
-                tile.QuantityUpdate( false );
+        std::vector<int32_t> weekLifeTiles;
+        for ( const Maps::Tiles & tile : vec_tiles ) {
+            if ( MP2::isWeekLife( tile.GetObject( false ) ) || tile.GetObject() == MP2::OBJ_MONSTER ) {
+                weekLifeTiles.push_back( tile.GetIndex() );
             }
         }
+
+        // Weekly update of an object changes only its own tile so all of them are updated at once.
+        fheroes2::parallelForWithSeed( weekLifeTiles.size(), _weekSeed, [this, &weekLifeTiles]( const size_t id ) {
+            vec_tiles[weekLifeTiles[id]].QuantityUpdate( false );
+        } );
     }
 
     // add events
@@ -1278,7 +1298,7 @@ uint32_t World::CheckKingdomLoss( const Kingdom & kingdom ) const
 
 u32 World::GetUniq( void )
 {
-    return ++GameStatic::uniq;
+    return ++Get()._uniq;
 }
 
 uint32_t World::getDistance( const Heroes & hero, int targetIndex )
@@ -1287,7 +1307,7 @@ uint32_t World::getDistance( const Heroes & hero, int targetIndex )
     return _pathfinder.getDistance( targetIndex );
 }
 
-std::list<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
+Route::StepList World::getPath( const Heroes & hero, int targetIndex )
 {
     _pathfinder.reEvaluateIfNeeded( hero );
     return _pathfinder.buildPath( targetIndex );
@@ -1299,19 +1319,166 @@ void World::resetPathfinder()
     AI::Get().resetPathfinder();
 }
 
+std::vector<int> World::getRegionRoute( int start, int targetIndex, uint8_t skill )
+{
+    std::vector<int> route;
+
+    if ( _regionPathfinder.getDistance( start, targetIndex, skill ) == 0 )
+        return route;
+
+    const std::vector<int> & portalRoute = _regionPathfinder.getPortalRoute();
+
+    route.reserve( portalRoute.size() + 1 );
+    route.push_back( _regionPathfinder.getFirstLegTarget() );
+    route.insert( route.end(), portalRoute.begin(), portalRoute.end() );
+
+    return route;
+}
+
+uint32_t World::getMinimumRegionDistance( int start, int targetIndex )
+{
+    return _regionPathfinder.getMinimumDistance( start, targetIndex );
+}
+
+void World::resetRegionPathfinder( int tileIndex )
+{
+    _regionPathfinder.invalidateTile( tileIndex );
+}
+
+void World::updateActionObjectTile( const int32_t tileIndex )
+{
+    // The list doesn't exist while the map is being loaded.
+    if ( tileIndex < 0 || static_cast<size_t>( tileIndex ) >= _isActionObjectTile.size() ) {
+        return;
+    }
+
+    const uint8_t isActionObject = isActionObjectTile( vec_tiles[tileIndex] ) ? 1 : 0;
+    if ( _isActionObjectTile[tileIndex] == isActionObject ) {
+        return;
+    }
+
+    _isActionObjectTile[tileIndex] = isActionObject;
+
+    const auto it = std::lower_bound( _actionObjectTiles.begin(), _actionObjectTiles.end(), tileIndex );
+    if ( isActionObject ) {
+        _actionObjectTiles.insert( it, tileIndex );
+    }
+    else {
+        assert( it != _actionObjectTiles.end() && *it == tileIndex );
+        _actionObjectTiles.erase( it );
+    }
+}
+
+void World::resetActionObjectTiles()
+{
+    _actionObjectTiles.clear();
+    _isActionObjectTile.assign( vec_tiles.size(), 0 );
+
+    for ( const Maps::Tiles & tile : vec_tiles ) {
+        if ( isActionObjectTile( tile ) ) {
+            _isActionObjectTile[tile.GetIndex()] = 1;
+            _actionObjectTiles.push_back( tile.GetIndex() );
+        }
+    }
+
+    // Fingerprint of an empty region is 0 so all other regions are calculated on the first request.
+    _regionObjectSummaries.assign( _regions.size(), RegionObjectSummary() );
+    _regionObjectFingerprints.assign( _regions.size(), 0 );
+}
+
+const std::vector<World::RegionObjectSummary> & World::getRegionObjectSummaries() const
+{
+    // Fingerprints are cheap to calculate unlike the strength of monsters.
+    std::vector<size_t> fingerprints( _regionObjectSummaries.size(), 0 );
+
+    for ( const int32_t tileIndex : _actionObjectTiles ) {
+        const Maps::Tiles & tile = vec_tiles[tileIndex];
+        const uint32_t regionId = tile.GetRegion();
+        if ( regionId >= fingerprints.size() ) {
+            continue;
+        }
+
+        const MP2::MapObjectType objectType = tile.GetObject();
+
+        size_t & fingerprint = fingerprints[regionId];
+        fheroes2::hashCombine( fingerprint, tileIndex );
+        fheroes2::hashCombine( fingerprint, static_cast<int>( objectType ) );
+
+        if ( objectType == MP2::OBJ_MONSTER ) {
+            fheroes2::hashCombine( fingerprint, tile.QuantityMonster().GetID() );
+            fheroes2::hashCombine( fingerprint, tile.MonsterCount() );
+        }
+    }
+
+    std::vector<uint8_t> isChanged( fingerprints.size(), 0 );
+    bool isAnyChanged = false;
+
+    for ( size_t regionId = 0; regionId < fingerprints.size(); ++regionId ) {
+        if ( fingerprints[regionId] != _regionObjectFingerprints[regionId] ) {
+            isChanged[regionId] = 1;
+            isAnyChanged = true;
+
+            _regionObjectSummaries[regionId] = RegionObjectSummary();
+        }
+    }
+
+    if ( !isAnyChanged ) {
+        return _regionObjectSummaries;
+    }
+
+    for ( const int32_t tileIndex : _actionObjectTiles ) {
+        const Maps::Tiles & tile = vec_tiles[tileIndex];
+        const uint32_t regionId = tile.GetRegion();
+        if ( regionId >= isChanged.size() || !isChanged[regionId] ) {
+            continue;
+        }
+
+        RegionObjectSummary & summary = _regionObjectSummaries[regionId];
+        ++summary.objectCount;
+
+        if ( tile.GetObject() == MP2::OBJ_MONSTER ) {
+            ++summary.monsterCount;
+            summary.monsterStrength += Army( tile ).GetStrength();
+        }
+    }
+
+    _regionObjectFingerprints.swap( fingerprints );
+
+    return _regionObjectSummaries;
+}
+
+void World::resetFogPlanes()
+{
+    _fogPlanes.reset( width, height );
+    for ( const Maps::Tiles & tile : vec_tiles ) {
+        _fogPlanes.setFog( tile.GetIndex(), tile.getFogColors() );
+    }
+}
+
 void World::PostLoad( const bool setTilePassabilities )
 {
+    resetFogPlanes();
+
     if ( setTilePassabilities ) {
-        // update tile passable
+        // Changing an object resets pathfinders so it must be done sequentially.
         for ( Maps::Tiles & tile : vec_tiles ) {
             tile.updateEmpty();
-            tile.setInitialPassability();
         }
 
+        // Passability of a tile depends only on objects of the tile and its neighbours so rows are processed in parallel.
+        const auto processRows = [this]( void ( Maps::Tiles::*update )() ) {
+            fheroes2::parallelFor( static_cast<size_t>( height ), [this, update]( const size_t y ) {
+                const int32_t rowStart = static_cast<int32_t>( y ) * width;
+                for ( int32_t i = rowStart; i < rowStart + width; ++i ) {
+                    ( vec_tiles[i].*update )();
+                }
+            } );
+        };
+
+        processRows( &Maps::Tiles::setInitialPassability );
+
         // Once the original passabilities are set we know all neighbours. Now we have to update passabilities based on neighbours.
-        for ( Maps::Tiles & tile : vec_tiles ) {
-            tile.updatePassability();
-        }
+        processRows( &Maps::Tiles::updatePassability );
     }
 
     // cache data that's accessed often
@@ -1320,6 +1487,9 @@ void World::PostLoad( const bool setTilePassabilities )
 
     resetPathfinder();
     ComputeStaticAnalysis();
+
+    // regions are known only now
+    resetActionObjectTiles();
 }
 
 uint32_t World::GetMapSeed() const
@@ -1419,9 +1589,19 @@ StreamBase & operator<<( StreamBase & msg, const World & w )
     const uint16_t width = static_cast<uint16_t>( w.width );
     const uint16_t height = static_cast<uint16_t>( w.height );
 
-    return msg << width << height << w.vec_tiles << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w.vec_rumors << w.vec_eventsday << w.map_captureobj
-               << w.ultimate_artifact << w.day << w.week << w.month << w.week_current << w.week_next << w.heroes_cond_wins << w.heroes_cond_loss << w.map_actions
-               << w.map_objects << w._seed;
+    msg << width << height;
+
+    Maps::writeTiles( msg, w.vec_tiles );
+
+    msg << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w.vec_rumors << w.vec_eventsday << w.map_captureobj << w.ultimate_artifact << w.day << w.week << w.month
+        << w.week_current << w.week_next << w.heroes_cond_wins << w.heroes_cond_loss << w.map_actions << w.map_objects << w._seed;
+
+    // Generators use only the lower 32 bits of their seeds.
+    for ( size_t i = 0; i < w._randomContext.Count(); ++i ) {
+        msg << static_cast<uint32_t>( w._randomContext.Get( i ).GetSeed() );
+    }
+
+    return msg;
 }
 
 StreamBase & operator>>( StreamBase & msg, World & w )
@@ -1434,9 +1614,31 @@ StreamBase & operator>>( StreamBase & msg, World & w )
     w.width = width;
     w.height = height;
 
-    msg >> w.vec_tiles >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w.vec_rumors >> w.vec_eventsday >> w.map_captureobj >> w.ultimate_artifact >> w.day >> w.week
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE1_098_RELEASE, "Remove the check below." );
+    if ( Game::GetLoadVersion() >= FORMAT_VERSION_PRE1_098_RELEASE ) {
+        Maps::readTiles( msg, w.vec_tiles );
+    }
+    else {
+        // Tiles were saved one by one before.
+        msg >> w.vec_tiles;
+    }
+
+    msg >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w.vec_rumors >> w.vec_eventsday >> w.map_captureobj >> w.ultimate_artifact >> w.day >> w.week
         >> w.month >> w.week_current >> w.week_next >> w.heroes_cond_wins >> w.heroes_cond_loss >> w.map_actions >> w.map_objects >> w._seed;
 
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE2_098_RELEASE, "Remove the check below." );
+    if ( Game::GetLoadVersion() >= FORMAT_VERSION_PRE2_098_RELEASE ) {
+        for ( size_t i = 0; i < w._randomContext.Count(); ++i ) {
+            uint32_t seed = 0;
+            msg >> seed;
+
+            w._randomContext.UpdateSeed( i, seed );
+        }
+    }
+    else {
+        w._randomContext.Reset( w._seed );
+    }
+
     w.PostLoad( false );
 
     return msg;
@@ -29,7 +29,9 @@
 #include "castle_heroes.h"
 #include "kingdom.h"
 #include "maps.h"
+#include "maps_fog.h"
 #include "maps_tiles.h"
+#include "rand.h"
 #include "week.h"
 #include "world_pathfinding.h"
 #include "world_regions.h"
@@ -147,6 +149,11 @@ struct EventDate
 StreamBase & operator<<( StreamBase &, const EventDate & );
 StreamBase & operator>>( StreamBase &, EventDate & );
 
+namespace Game
+{
+    class Session;
+}
+
 using Rumors = std::list<std::string>;
 using EventsDate = std::list<EventDate>;
 using MapsTiles = std::vector<Maps::Tiles>;
@@ -167,6 +174,7 @@ public:
 
     void NewMaps( int32_t, int32_t );
 
+    // Returns the world of the game session of the calling thread.
     static World & Get( void );
 
     int32_t w() const
@@ -272,18 +280,73 @@ public:
     MapEvent * GetMapEvent( const fheroes2::Point & );
     MapObjectSimple * GetMapObject( u32 uid );
     void RemoveMapObject( const MapObjectSimple * );
+    const Maps::FogPlanes & getFogPlanes() const
+    {
+        return _fogPlanes;
+    }
+
+    Maps::FogPlanes & getFogPlanes()
+    {
+        return _fogPlanes;
+    }
+
     const MapRegion & getRegion( size_t id ) const;
     size_t getRegionCount() const;
 
+    // Objects of a region which are the same for all kingdoms.
+    struct RegionObjectSummary
+    {
+        uint32_t objectCount = 0;
+        uint32_t monsterCount = 0;
+        double monsterStrength = 0;
+    };
+
+    // Indexes of tiles with action objects (including heroes and coast) in ascending order. Most of the map is empty ground so
+    // full map scans looking for objects should go through these tiles instead.
+    const std::vector<int32_t> & getActionObjectTiles() const
+    {
+        return _actionObjectTiles;
+    }
+
+    // Summaries of all regions. Only regions with changed objects are recalculated since the last call.
+    const std::vector<RegionObjectSummary> & getRegionObjectSummaries() const;
+
+    // Called when an object on the tile has been changed.
+    void updateActionObjectTile( const int32_t tileIndex );
+
     uint32_t getDistance( const Heroes & hero, int targetIndex );
-    std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
+    Route::StepList getPath( const Heroes & hero, int targetIndex );
     void resetPathfinder();
 
+    // Region-level route from start to target: the last tile of the first leg followed by portal tiles and the target. Much cheaper than a full map
+    // search but boats, monsters and other objects on the way are not taken into account. Returns an empty list if target cannot be reached.
+    std::vector<int> getRegionRoute( int start, int targetIndex, uint8_t skill );
+
+    // Lower bound of the movement cost of an army from start to target (see RegionPathfinder::getMinimumDistance). No army can reach the target
+    // faster so targets can be discarded without a full map search. Returns std::numeric_limits<uint32_t>::max() if target cannot be reached.
+    uint32_t getMinimumRegionDistance( int start, int targetIndex );
+    void resetRegionPathfinder( int tileIndex );
+
     void ComputeStaticAnalysis();
     static u32 GetUniq( void );
 
     uint32_t GetMapSeed() const;
 
+    // Independent random streams of the game. All of them are derived from the map seed and saved with the game
+    // so AI decisions do not depend on the random calls made by other parts of the game.
+    enum class RandomStream : uint8_t
+    {
+        AI_HERO_ACTION,
+        AI_CASTLE,
+
+        COUNT
+    };
+
+    const Rand::DeterministicRandomGenerator & getRandomGenerator( const RandomStream stream ) const
+    {
+        return _randomContext.Get( static_cast<size_t>( stream ) );
+    }
+
     bool isAnyKingdomVisited( const MP2::MapObjectType objectType, const int32_t dstIndex ) const;
 
 private:
@@ -299,10 +362,13 @@ private:
     void ProcessNewMap();
     void PostLoad( const bool setTilePassabilities );
     void pickRumor();
+    void resetActionObjectTiles();
+    void resetFogPlanes();
 
     bool isValidCastleEntrance( const fheroes2::Point & tilePosition ) const;
 
     friend class Radar;
+    friend class Game::Session;
     friend StreamBase & operator<<( StreamBase &, const World & );
     friend StreamBase & operator>>( StreamBase &, World & );
 
@@ -336,10 +402,18 @@ private:
     Maps::Indexes _allTeleporters;
     Maps::Indexes _whirlpoolTiles;
     std::vector<MapRegion> _regions;
+    std::vector<int32_t> _actionObjectTiles;
+    std::vector<uint8_t> _isActionObjectTile;
+    mutable std::vector<RegionObjectSummary> _regionObjectSummaries;
+    mutable std::vector<size_t> _regionObjectFingerprints;
+    Maps::FogPlanes _fogPlanes;
     PlayerWorldPathfinder _pathfinder;
+    RegionPathfinder _regionPathfinder;
 
     uint32_t _seed{ 0 }; // global seed for the map
     size_t _weekSeed{ 0 }; // global seed for the map, for this week
+    uint32_t _uniq{ 0 }; // the last unique identifier of map objects
+    Rand::DeterministicRandomContext _randomContext{ static_cast<size_t>( RandomStream::COUNT ) };
 };
 
 StreamBase & operator<<( StreamBase &, const CapturedObject & );
@@ -353,6 +427,7 @@ StreamBase & operator>>( StreamBase &, ListActions & );
 StreamBase & operator<<( StreamBase &, const MapObjects & );
 StreamBase & operator>>( StreamBase &, MapObjects & );
 
-extern World & world;
+// The world of the game session of the calling thread. The reference is bound when the thread uses it for the first time.
+extern thread_local World & world;
 
 #endif
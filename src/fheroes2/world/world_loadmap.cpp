@@ -35,6 +35,7 @@
 #include "maps_tiles.h"
 #include "mp2.h"
 #include "mp2_helper.h"
+#include "parallel.h"
 #include "race.h"
 #include "rand.h"
 #include "serialize.h"
@@ -96,11 +97,6 @@ namespace
     }
 }
 
-namespace GameStatic
-{
-    extern u32 uniq;
-}
-
 bool World::LoadMapMP2( const std::string & filename )
 {
     Reset();
@@ -121,7 +117,7 @@ bool World::LoadMapMP2( const std::string & filename )
     fs.seek( endof_mp2 - 4 );
 
     // read uniq
-    GameStatic::uniq = fs.getLE32();
+    _uniq = fs.getLE32();
 
     // offset data
     fs.seek( MP2::MP2OFFSETDATA - 2 * 4 );
@@ -218,8 +214,6 @@ bool World::LoadMapMP2( const std::string & filename )
             addonIndex = vec_mp2addons[addonIndex].nextAddonIndex;
         }
 
-        tile.AddonsSort();
-
         switch ( mp2tile.mapObjectType ) {
         case MP2::OBJ_RNDTOWN:
         case MP2::OBJ_RNDCASTLE:
@@ -239,6 +233,14 @@ bool World::LoadMapMP2( const std::string & filename )
 
     DEBUG_LOG( DBG_GAME, DBG_INFO, "read all tiles, tellg: " << fs.tell() );
 
+    // Addons of every tile are sorted independently so it is done by rows in parallel.
+    fheroes2::parallelFor( static_cast<size_t>( height ), [this]( const size_t y ) {
+        const int32_t rowStart = static_cast<int32_t>( y ) * width;
+        for ( int32_t i = rowStart; i < rowStart + width; ++i ) {
+            vec_tiles[i].AddonsSort();
+        }
+    } );
+
     // after addons
     fs.seek( endof_addons );
 
@@ -373,41 +375,63 @@ bool World::LoadMapMP2( const std::string & filename )
         }
     }
 
+    // Every object tile refers to its block by the order number stored in tile quantities.
+    std::vector<int32_t> blockTileIndexes( countblock, -1 );
+    for ( const int32_t tileIndex : vec_object ) {
+        const Maps::Tiles & tile = vec_tiles[tileIndex];
+
+        // orders(quantity2, quantity1)
+        const uint32_t orders = ( static_cast<uint32_t>( tile.GetQuantity2() ) << 8 ) | tile.GetQuantity1();
+        if ( orders == 0 || orders % 0x08 != 0 ) {
+            continue;
+        }
+
+        const uint32_t blockId = orders / 0x08 - 1;
+        if ( blockId < countblock && blockTileIndexes[blockId] < 0 ) {
+            blockTileIndexes[blockId] = tileIndex;
+        }
+    }
+
+    // All blocks are read at once and parsed directly from this buffer.
+    const std::vector<uint8_t> blocksData = fs.getRaw();
+    size_t blockOffset = 0;
+
     // castle or heroes or (events, rumors, etc)
     for ( u32 ii = 0; ii < countblock; ++ii ) {
-        s32 findobject = -1;
-
         // read block
-        size_t sizeblock = fs.getLE16();
-        std::vector<u8> pblock = fs.getRaw( sizeblock );
-
-        for ( MapsIndexes::const_iterator it_index = vec_object.begin(); it_index != vec_object.end() && findobject < 0; ++it_index ) {
-            const Maps::Tiles & tile = vec_tiles[*it_index];
+        if ( blockOffset + 2 > blocksData.size() ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "read maps: unexpected end of data, block: " << ii )
+            break;
+        }
 
-            // orders(quantity2, quantity1)
-            u32 orders = ( tile.GetQuantity2() ? tile.GetQuantity2() : 0 );
-            orders <<= 8;
-            orders |= tile.GetQuantity1();
+        const size_t sizeblock = static_cast<size_t>( blocksData[blockOffset] ) | ( static_cast<size_t>( blocksData[blockOffset + 1] ) << 8 );
+        blockOffset += 2;
 
-            if ( orders && !( orders % 0x08 ) && ( ii + 1 == orders / 0x08 ) )
-                findobject = *it_index;
+        if ( blockOffset + sizeblock > blocksData.size() ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "read maps: incorrect size of block: " << ii << ", size: " << sizeblock )
+            break;
         }
 
+        const uint8_t * pblock = blocksData.data() + blockOffset;
+        blockOffset += sizeblock;
+
+        const int32_t findobject = blockTileIndexes[ii];
+
         if ( 0 <= findobject ) {
             const Maps::Tiles & tile = vec_tiles[findobject];
 
             switch ( tile.GetObject() ) {
             case MP2::OBJ_CASTLE:
                 // add castle
-                if ( MP2::SIZEOFMP2CASTLE != pblock.size() ) {
+                if ( MP2::SIZEOFMP2CASTLE != sizeblock ) {
                     DEBUG_LOG( DBG_GAME, DBG_WARN,
                                "read castle: "
-                                   << "incorrect size block: " << pblock.size() );
+                                   << "incorrect size block: " << sizeblock );
                 }
                 else {
                     Castle * castle = getCastleEntrance( Maps::GetPoint( findobject ) );
                     if ( castle ) {
-                        castle->LoadFromMP2( pblock );
+                        castle->LoadFromMP2( StreamBuf( pblock, sizeblock ) );
                         map_captureobj.SetColor( tile.GetIndex(), castle->GetColor() );
                     }
                     else {
@@ -420,16 +444,16 @@ bool World::LoadMapMP2( const std::string & filename )
             case MP2::OBJ_RNDTOWN:
             case MP2::OBJ_RNDCASTLE:
                 // add rnd castle
-                if ( MP2::SIZEOFMP2CASTLE != pblock.size() ) {
+                if ( MP2::SIZEOFMP2CASTLE != sizeblock ) {
                     DEBUG_LOG( DBG_GAME, DBG_WARN,
                                "read castle: "
-                                   << "incorrect size block: " << pblock.size() );
+                                   << "incorrect size block: " << sizeblock );
                 }
                 else {
                     // Random castle's entrance tile is marked as OBJ_RNDCASTLE or OBJ_RNDTOWN instead of OBJ_CASTLE.
                     Castle * castle = getCastle( Maps::GetPoint( findobject ) );
                     if ( castle ) {
-                        castle->LoadFromMP2( pblock );
+                        castle->LoadFromMP2( StreamBuf( pblock, sizeblock ) );
                         Maps::UpdateCastleSprite( castle->GetCenter(), castle->GetRace(), castle->isCastle(), true );
                         Maps::ReplaceRandomCastleObjectId( castle->GetCenter() );
                         map_captureobj.SetColor( tile.GetIndex(), castle->GetColor() );
@@ -443,10 +467,10 @@ bool World::LoadMapMP2( const std::string & filename )
                 break;
             case MP2::OBJ_JAIL:
                 // add jail
-                if ( MP2::SIZEOFMP2HEROES != pblock.size() ) {
+                if ( MP2::SIZEOFMP2HEROES != sizeblock ) {
                     DEBUG_LOG( DBG_GAME, DBG_WARN,
                                "read heroes: "
-                                   << "incorrect size block: " << pblock.size() );
+                                   << "incorrect size block: " << sizeblock );
                 }
                 else {
                     int race = Race::KNGT;
@@ -473,17 +497,17 @@ bool World::LoadMapMP2( const std::string & filename )
                     Heroes * hero = GetFreemanHeroes( race );
 
                     if ( hero ) {
-                        hero->LoadFromMP2( findobject, Color::NONE, hero->GetRace(), StreamBuf( pblock ) );
+                        hero->LoadFromMP2( findobject, Color::NONE, hero->GetRace(), StreamBuf( pblock, sizeblock ) );
                         hero->SetModes( Heroes::JAIL );
                     }
                 }
                 break;
             case MP2::OBJ_HEROES:
                 // add heroes
-                if ( MP2::SIZEOFMP2HEROES != pblock.size() ) {
+                if ( MP2::SIZEOFMP2HEROES != sizeblock ) {
                     DEBUG_LOG( DBG_GAME, DBG_WARN,
                                "read heroes: "
-                                   << "incorrect size block: " << pblock.size() );
+                                   << "incorrect size block: " << sizeblock );
                 }
                 else {
                     std::pair<int, int> colorRace = Maps::Tiles::ColorRaceFromHeroSprite( tile.GetObjectSpriteIndex() );
@@ -503,7 +527,7 @@ bool World::LoadMapMP2( const std::string & filename )
                             hero = vec_heroes.GetFreeman( colorRace.second );
 
                         if ( hero )
-                            hero->LoadFromMP2( findobject, colorRace.first, colorRace.second, StreamBuf( pblock ) );
+                            hero->LoadFromMP2( findobject, colorRace.first, colorRace.second, StreamBuf( pblock, sizeblock ) );
                     }
                     else {
                         DEBUG_LOG( DBG_GAME, DBG_WARN, "load heroes maximum" );
@@ -513,25 +537,25 @@ bool World::LoadMapMP2( const std::string & filename )
             case MP2::OBJ_SIGN:
             case MP2::OBJ_BOTTLE:
                 // add sign or buttle
-                if ( MP2::SIZEOFMP2SIGN - 1 < pblock.size() && 0x01 == pblock[0] ) {
+                if ( MP2::SIZEOFMP2SIGN - 1 < sizeblock && 0x01 == pblock[0] ) {
                     MapSign * obj = new MapSign();
-                    obj->LoadFromMP2( findobject, StreamBuf( pblock ) );
+                    obj->LoadFromMP2( findobject, StreamBuf( pblock, sizeblock ) );
                     map_objects.add( obj );
                 }
                 break;
             case MP2::OBJ_EVENT:
                 // add event maps
-                if ( MP2::SIZEOFMP2EVENT - 1 < pblock.size() && 0x01 == pblock[0] ) {
+                if ( MP2::SIZEOFMP2EVENT - 1 < sizeblock && 0x01 == pblock[0] ) {
                     MapEvent * obj = new MapEvent();
-                    obj->LoadFromMP2( findobject, StreamBuf( pblock ) );
+                    obj->LoadFromMP2( findobject, StreamBuf( pblock, sizeblock ) );
                     map_objects.add( obj );
                 }
                 break;
             case MP2::OBJ_SPHINX:
                 // add riddle sphinx
-                if ( MP2::SIZEOFMP2RIDDLE - 1 < pblock.size() && 0x00 == pblock[0] ) {
+                if ( MP2::SIZEOFMP2RIDDLE - 1 < sizeblock && 0x00 == pblock[0] ) {
                     MapSphinx * obj = new MapSphinx();
-                    obj->LoadFromMP2( findobject, StreamBuf( pblock ) );
+                    obj->LoadFromMP2( findobject, StreamBuf( pblock, sizeblock ) );
                     map_objects.add( obj );
                 }
                 break;
@@ -540,23 +564,23 @@ bool World::LoadMapMP2( const std::string & filename )
             }
         }
         // other events
-        else if ( 0x00 == pblock[0] ) {
+        else if ( sizeblock > 0 && 0x00 == pblock[0] ) {
             // add event day
-            if ( MP2::SIZEOFMP2EVENT - 1 < pblock.size() && 1 == pblock[42] ) {
+            if ( MP2::SIZEOFMP2EVENT - 1 < sizeblock && 1 == pblock[42] ) {
                 vec_eventsday.emplace_back();
-                vec_eventsday.back().LoadFromMP2( StreamBuf( pblock ) );
+                vec_eventsday.back().LoadFromMP2( StreamBuf( pblock, sizeblock ) );
             }
             // add rumors
-            else if ( MP2::SIZEOFMP2RUMOR - 1 < pblock.size() ) {
+            else if ( MP2::SIZEOFMP2RUMOR - 1 < sizeblock ) {
                 if ( pblock[8] ) {
-                    vec_rumors.push_back( StreamBuf( &pblock[8], pblock.size() - 8 ).toString() );
+                    vec_rumors.push_back( StreamBuf( pblock + 8, sizeblock - 8 ).toString() );
                     DEBUG_LOG( DBG_GAME, DBG_INFO, "add rumors: " << vec_rumors.back() );
                 }
             }
         }
         // debug
         else {
-            DEBUG_LOG( DBG_GAME, DBG_WARN, "read maps: unknown block addons, size: " << pblock.size() );
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "read maps: unknown block addons, size: " << sizeblock );
         }
     }
 
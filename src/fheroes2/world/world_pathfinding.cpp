@@ -18,18 +18,30 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
 #include <set>
 
 #include "ground.h"
 #include "logging.h"
+#include "profiler.h"
 #include "rand.h"
 #include "world.h"
 #include "world_pathfinding.h"
 
 namespace
 {
+    const uint32_t noRegionPath = std::numeric_limits<uint32_t>::max();
+    const size_t noPortal = std::numeric_limits<size_t>::max();
+
+    // Portals between the same pair of regions must be at least this far from each other.
+    const uint32_t portalSpacing = 4;
+
     bool isTileBlocked( int tileIndex, bool fromWater )
     {
         const Maps::Tiles & tile = world.GetTiles( tileIndex );
@@ -80,6 +92,25 @@ namespace
         return MP2::isNeedStayFront( objectType );
     }
 
+    // Region-level pathfinding can reach such tiles but cannot move further. Stoneliths are an exception as they are connected by portals.
+    bool isRegionTileBlocked( const int tileIndex )
+    {
+        const Maps::Tiles & tile = world.GetTiles( tileIndex );
+        const MP2::MapObjectType objectType = tile.GetObject();
+
+        if ( objectType == MP2::OBJ_STONELITHS )
+            return false;
+
+        return MP2::isNeedStayFront( objectType ) || MP2::isActionObject( objectType, tile.isWater() );
+    }
+
+    // Moves between tiles are checked only against the tile passability so any move allowed by other rules is allowed here too.
+    bool isPassableIgnoringObjects( const int index, const int direction )
+    {
+        return world.GetTiles( index ).isPassableTo( direction )
+               && world.GetTiles( Maps::GetDirectionIndex( index, direction ) ).isPassableTo( Direction::Reflect( direction ) );
+    }
+
     bool isValidPath( const int index, const int direction, const int heroColor )
     {
         const Maps::Tiles & fromTile = world.GetTiles( index );
@@ -137,6 +168,40 @@ namespace
         const Maps::Tiles & toTile = world.GetTiles( Maps::GetDirectionIndex( index, direction ) );
         return toTile.isPassableFrom( Direction::Reflect( direction ), fromWater, false, heroColor );
     }
+
+    // Calculates the movement penalty when moving from the src tile to the adjacent dst tile in the specified direction. If applyLastMove is set
+    // then the "last move" logic is applied for the given remaining movement points at the src tile.
+    uint32_t calculateMovementPenalty( const int src, const int dst, const int direction, const uint8_t skill, const bool applyLastMove,
+                                       const uint32_t remainingMovePoints )
+    {
+        const Maps::Tiles & srcTile = world.GetTiles( src );
+        const Maps::Tiles & dstTile = world.GetTiles( dst );
+
+        uint32_t penalty = srcTile.isRoad() && dstTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( srcTile, skill );
+
+        // Diagonal movement costs 50% more
+        if ( Direction::isDiagonal( direction ) ) {
+            penalty = penalty * 3 / 2;
+        }
+
+        // If we perform pathfinding for a real hero on the map, we have to work out the "last move"
+        // logic: if this move is the last one on the current turn, then we can move to any adjacent
+        // tile (both in straight and diagonal direction) as long as we have enough movement points
+        // to move over our current tile in the straight direction
+        if ( applyLastMove ) {
+            const uint32_t srcTilePenalty = srcTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( srcTile, skill );
+
+            // If we still have enough movement points to move over the src tile in the straight
+            // direction, but not enough to move to the dst tile, then the "last move" logic is
+            // applied and we can move to the dst tile anyway at the expense of all the remaining
+            // movement points
+            if ( remainingMovePoints >= srcTilePenalty && remainingMovePoints < penalty ) {
+                return remainingMovePoints;
+            }
+        }
+
+        return penalty;
+    }
 }
 
 void WorldPathfinder::checkWorldSize()
@@ -157,39 +222,16 @@ void WorldPathfinder::checkWorldSize()
 
 uint32_t WorldPathfinder::getMovementPenalty( int src, int dst, int direction ) const
 {
-    const Maps::Tiles & srcTile = world.GetTiles( src );
-    const Maps::Tiles & dstTile = world.GetTiles( dst );
-
-    uint32_t penalty = srcTile.isRoad() && dstTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( srcTile, _pathfindingSkill );
-
-    // Diagonal movement costs 50% more
-    if ( Direction::isDiagonal( direction ) ) {
-        penalty = penalty * 3 / 2;
+    if ( _maxMovePoints == 0 ) {
+        return calculateMovementPenalty( src, dst, direction, _pathfindingSkill, false, 0 );
     }
 
-    // If we perform pathfinding for a real hero on the map, we have to work out the "last move"
-    // logic: if this move is the last one on the current turn, then we can move to any adjacent
-    // tile (both in straight and diagonal direction) as long as we have enough movement points
-    // to move over our current tile in the straight direction
-    if ( _maxMovePoints > 0 ) {
-        const WorldNode & node = _cache[src];
-
-        // No dead ends allowed
-        assert( src == _pathStart || node._from != -1 );
+    const WorldNode & node = _cache[src];
 
-        const uint32_t remainingMovePoints = node._remainingMovePoints;
-        const uint32_t srcTilePenalty = srcTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( srcTile, _pathfindingSkill );
+    // No dead ends allowed
+    assert( src == _pathStart || node._from != -1 );
 
-        // If we still have enough movement points to move over the src tile in the straight
-        // direction, but not enough to move to the dst tile, then the "last move" logic is
-        // applied and we can move to the dst tile anyway at the expense of all the remaining
-        // movement points
-        if ( remainingMovePoints >= srcTilePenalty && remainingMovePoints < penalty ) {
-            return remainingMovePoints;
-        }
-    }
-
-    return penalty;
+    return calculateMovementPenalty( src, dst, direction, _pathfindingSkill, true, node._remainingMovePoints );
 }
 
 uint32_t WorldPathfinder::substractMovePoints( const uint32_t movePoints, const uint32_t substractedMovePoints ) const
@@ -213,6 +255,8 @@ uint32_t WorldPathfinder::substractMovePoints( const uint32_t movePoints, const
 
 void WorldPathfinder::processWorldMap( int pathStart )
 {
+    PROFILE_ZONE( "WorldPathfinder::processWorldMap" );
+
     // reset cache back to default value
     for ( size_t idx = 0; idx < _cache.size(); ++idx ) {
         _cache[idx].resetNode();
@@ -291,9 +335,9 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     }
 }
 
-std::list<Route::Step> PlayerWorldPathfinder::buildPath( int targetIndex ) const
+Route::StepList PlayerWorldPathfinder::buildPath( int targetIndex ) const
 {
-    std::list<Route::Step> path;
+    Route::StepList path;
 
     // trace the path from end point
     int currentNode = targetIndex;
@@ -301,7 +345,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( int targetIndex ) const
         const WorldNode & node = _cache[currentNode];
         const uint32_t cost = ( node._from != -1 ) ? node._cost - _cache[node._from]._cost : node._cost;
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_back( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
 
         // Sanity check
         if ( node._from != -1 && _cache[node._from]._from == currentNode ) {
@@ -318,9 +362,106 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( int targetIndex ) const
         path.clear();
     }
 
+    // the path was traced from the end point
+    std::reverse( path.begin(), path.end() );
+
     return path;
 }
 
+bool PlayerWorldPathfinder::reconnectPath( const Heroes & hero, Route::Path & path )
+{
+    const int32_t heroIndex = hero.GetIndex();
+
+    // The hero is at the start of the path, there is nothing to reconnect.
+    if ( path.empty() || path.front().GetFrom() == heroIndex ) {
+        return false;
+    }
+
+    // Find the furthest step of the path leading to the tile where the hero stands or to an adjacent tile.
+    Route::Path::const_iterator joinStep = path.end();
+    bool isHeroOnPath = false;
+
+    for ( Route::Path::const_iterator step = path.begin(); step != path.end(); ++step ) {
+        const int32_t stepIndex = step->GetIndex();
+        if ( stepIndex == heroIndex ) {
+            joinStep = step;
+            isHeroOnPath = true;
+            continue;
+        }
+
+        const int direction = Maps::GetDirection( heroIndex, stepIndex );
+        if ( direction != Direction::UNKNOWN && direction != Direction::CENTER && Maps::isValidDirection( heroIndex, direction ) ) {
+            joinStep = step;
+            isHeroOnPath = false;
+        }
+    }
+
+    if ( joinStep == path.end() ) {
+        return false;
+    }
+
+    const bool fromWater = world.GetTiles( heroIndex ).isWater();
+    const int color = hero.GetColor();
+    const uint8_t skill = static_cast<uint8_t>( hero.GetLevelSkill( Skill::Secondary::PATHFINDING ) );
+    const uint32_t maxMovePoints = hero.GetMaxMovePoints();
+    uint32_t remainingMovePoints = hero.GetMovePoints();
+
+    Route::StepList steps;
+    steps.reserve( static_cast<size_t>( path.end() - joinStep ) + 1 );
+
+    int32_t from = heroIndex;
+
+    // Follows the same passability rules as the search over the whole map. Tiles protected by monsters are not allowed on the way.
+    const auto addStep = [&]( const int32_t to ) {
+        const int direction = Maps::GetDirection( from, to );
+        if ( direction == Direction::UNKNOWN || direction == Direction::CENTER || !Maps::isValidDirection( from, direction ) || !isValidPath( from, direction, color ) ) {
+            return false;
+        }
+
+        if ( from != heroIndex ) {
+            const MP2::MapObjectType objectType = world.GetTiles( from ).GetObject();
+            if ( objectType == MP2::OBJ_MONSTER || objectType == MP2::OBJ_BARRIER || isTileBlocked( from, fromWater ) || !Maps::GetTilesUnderProtection( from ).empty() ) {
+                return false;
+            }
+        }
+
+        const uint32_t penalty = calculateMovementPenalty( from, to, direction, skill, true, remainingMovePoints );
+        if ( remainingMovePoints >= penalty ) {
+            remainingMovePoints -= penalty;
+        }
+        else if ( maxMovePoints >= penalty ) {
+            // the step is made on the next turn
+            remainingMovePoints = maxMovePoints - penalty;
+        }
+        else {
+            return false;
+        }
+
+        steps.emplace_back( to, from, direction, penalty );
+        from = to;
+
+        return true;
+    };
+
+    if ( !isHeroOnPath && !addStep( joinStep->GetIndex() ) ) {
+        return false;
+    }
+
+    for ( Route::Path::const_iterator step = joinStep + 1; step != path.end(); ++step ) {
+        if ( !addStep( step->GetIndex() ) ) {
+            return false;
+        }
+    }
+
+    if ( steps.empty() ) {
+        return false;
+    }
+
+    path.setPath( std::move( steps ), path.GetDestinationIndex() );
+
+    return true;
+}
+
 // Follows regular (for user's interface) passability rules
 void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, int pathStart, int currentNodeIdx )
 {
@@ -372,6 +513,11 @@ void AIWorldPathfinder::reset()
 }
 
 void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
+{
+    _reEvaluateHero( hero, _searchDayLimit * hero.GetMaxMovePoints() );
+}
+
+void AIWorldPathfinder::_reEvaluateHero( const Heroes & hero, const uint32_t searchCostLimit )
 {
     const int startIndex = hero.GetIndex();
     const int color = hero.GetColor();
@@ -380,14 +526,17 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     const uint32_t remainingMovePoints = hero.GetMovePoints();
     const uint32_t maxMovePoints = hero.GetMaxMovePoints();
 
+    // Results of a search without the limit can be reused for any limit
     if ( _pathStart != startIndex || _currentColor != color || std::fabs( _armyStrength - armyStrength ) > 0.001 || _pathfindingSkill != skill
-         || _remainingMovePoints != remainingMovePoints || _maxMovePoints != maxMovePoints ) {
+         || _remainingMovePoints != remainingMovePoints || _maxMovePoints != maxMovePoints || ( _searchCostLimit != 0 && _searchCostLimit != searchCostLimit ) ) {
         _pathStart = startIndex;
         _currentColor = color;
         _armyStrength = armyStrength;
         _pathfindingSkill = skill;
         _remainingMovePoints = remainingMovePoints;
         _maxMovePoints = maxMovePoints;
+        _searchCostLimit = searchCostLimit;
+        _isSearchLimitReached = false;
 
         processWorldMap( startIndex );
     }
@@ -395,13 +544,15 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
 
 void AIWorldPathfinder::reEvaluateIfNeeded( int start, int color, double armyStrength, uint8_t skill )
 {
-    if ( _pathStart != start || _currentColor != color || std::fabs( _armyStrength - armyStrength ) > 0.001 || _pathfindingSkill != skill ) {
+    if ( _pathStart != start || _currentColor != color || std::fabs( _armyStrength - armyStrength ) > 0.001 || _pathfindingSkill != skill || _searchCostLimit != 0 ) {
         _pathStart = start;
         _currentColor = color;
         _armyStrength = armyStrength;
         _pathfindingSkill = skill;
         _remainingMovePoints = 0;
         _maxMovePoints = 0;
+        _searchCostLimit = 0;
+        _isSearchLimitReached = false;
 
         processWorldMap( start );
     }
@@ -413,6 +564,12 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, i
     const bool isFirstNode = currentNodeIdx == pathStart;
     WorldNode & currentNode = _cache[currentNodeIdx];
 
+    // Costs of all tiles within the limit are still exact as their routes consist of tiles within the limit only
+    if ( _searchCostLimit > 0 && currentNode._cost > _searchCostLimit ) {
+        _isSearchLimitReached = true;
+        return;
+    }
+
     // find out if current node is protected by a strong army
     auto protectionCheck = [this]( const int index ) {
         const Maps::Tiles & tile = world.GetTiles( index );
@@ -501,6 +658,19 @@ int AIWorldPathfinder::getFogDiscoveryTile( const Heroes & hero )
 {
     // paths have to be pre-calculated to find a spot where we're able to move
     reEvaluateIfNeeded( hero );
+
+    int fogDiscoveryTile = _findFogDiscoveryTile( hero );
+    if ( fogDiscoveryTile == -1 && _isSearchLimitReached ) {
+        // The fog might be beyond the search limit
+        _reEvaluateHero( hero, 0 );
+        fogDiscoveryTile = _findFogDiscoveryTile( hero );
+    }
+
+    return fogDiscoveryTile;
+}
+
+int AIWorldPathfinder::_findFogDiscoveryTile( const Heroes & hero ) const
+{
     const int start = hero.GetIndex();
 
     const Directions & directions = Direction::All();
@@ -660,9 +830,9 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( int targetIndex,
     return result;
 }
 
-std::list<Route::Step> AIWorldPathfinder::buildPath( int targetIndex, bool isPlanningMode ) const
+Route::StepList AIWorldPathfinder::buildPath( int targetIndex, bool isPlanningMode ) const
 {
-    std::list<Route::Step> path;
+    Route::StepList path;
     if ( _pathStart == -1 )
         return path;
 
@@ -679,7 +849,7 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( int targetIndex, bool isPla
         const WorldNode & node = _cache[currentNode];
         const uint32_t cost = ( node._from != -1 ) ? node._cost - _cache[node._from]._cost : node._cost;
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_back( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
 
         // Sanity check
         if ( node._from != -1 && _cache[node._from]._from == currentNode ) {
@@ -691,6 +861,9 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( int targetIndex, bool isPla
         }
     }
 
+    // the path was traced from the end point
+    std::reverse( path.begin(), path.end() );
+
     // Cut the path to the last valid tile/obstacle if not in planning mode
     if ( !isPlanningMode && lastValidNode != targetIndex ) {
         path.erase( std::find_if( path.begin(), path.end(), [&lastValidNode]( const Route::Step & step ) { return step.GetFrom() == lastValidNode; } ), path.end() );
@@ -712,3 +885,604 @@ void AIWorldPathfinder::setArmyStrengthMultplier( const double multiplier )
         reset();
     }
 }
+
+void AIWorldPathfinder::setSearchDayLimit( const uint32_t days )
+{
+    if ( _searchDayLimit != days ) {
+        _searchDayLimit = days;
+        reset();
+    }
+}
+
+void RegionPathfinder::reset()
+{
+    WorldPathfinder::checkWorldSize();
+
+    if ( _pathStart != -1 ) {
+        _pathStart = -1;
+        _firstLegTarget = -1;
+        _portalRoute.clear();
+    }
+}
+
+void RegionPathfinder::rebuild()
+{
+    PROFILE_ZONE( "RegionPathfinder::rebuild" );
+
+    reset();
+
+    _portals.clear();
+    _regions.clear();
+    _regions.resize( world.getRegionCount() );
+    _regionBounds.clear();
+    _regionBounds.resize( world.getRegionCount() );
+    _boundStart = -1;
+
+    const int32_t worldSize = static_cast<int32_t>( world.getSize() );
+    _tileRegionIndex.assign( worldSize, -1 );
+    _tilePortal.assign( worldSize, -1 );
+
+    for ( int32_t idx = 0; idx < worldSize; ++idx ) {
+        const uint32_t regionId = world.GetTiles( idx ).GetRegion();
+        if ( regionId >= REGION_NODE_FOUND && regionId < _regions.size() ) {
+            std::vector<int> & tiles = _regions[regionId].tiles;
+            _tileRegionIndex[idx] = static_cast<int>( tiles.size() );
+            tiles.push_back( idx );
+        }
+    }
+
+    auto getPortal = [this]( const int index ) {
+        if ( _tilePortal[index] < 0 ) {
+            const uint32_t regionId = world.GetTiles( index ).GetRegion();
+            std::vector<size_t> & regionPortals = _regions[regionId].portals;
+
+            Portal portal;
+            portal.index = index;
+            portal.region = regionId;
+            portal.regionPortalId = regionPortals.size();
+
+            _tilePortal[index] = static_cast<int>( _portals.size() );
+            regionPortals.push_back( _portals.size() );
+            _portals.push_back( portal );
+        }
+
+        return static_cast<size_t>( _tilePortal[index] );
+    };
+
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<int>> borderExits;
+    const Directions & directions = Direction::All();
+
+    for ( int32_t idx = 0; idx < worldSize; ++idx ) {
+        if ( _tileRegionIndex[idx] < 0 )
+            continue;
+
+        const Maps::Tiles & tile = world.GetTiles( idx );
+        const uint32_t regionId = tile.GetRegion();
+
+        for ( size_t i = 0; i < directions.size(); ++i ) {
+            if ( !Maps::isValidDirection( idx, directions[i] ) )
+                continue;
+
+            const int newIndex = idx + _mapOffset[i];
+            if ( _tileRegionIndex[newIndex] < 0 || world.GetTiles( newIndex ).GetRegion() == regionId || !isValidPath( idx, directions[i], Color::NONE ) )
+                continue;
+
+            std::vector<int> & exits = borderExits[std::make_pair( regionId, world.GetTiles( newIndex ).GetRegion() )];
+            if ( std::any_of( exits.begin(), exits.end(), [idx]( const int exitIdx ) { return Maps::GetApproximateDistance( exitIdx, idx ) < portalSpacing; } ) )
+                continue;
+
+            exits.push_back( idx );
+
+            const size_t from = getPortal( idx );
+            const size_t to = getPortal( newIndex );
+            _portals[from].exits.emplace_back( to, directions[i] );
+        }
+
+        if ( tile.GetObject( false ) == MP2::OBJ_STONELITHS ) {
+            for ( const int exitIdx : world.GetTeleportEndPoints( idx ) ) {
+                if ( _tileRegionIndex[exitIdx] < 0 )
+                    continue;
+
+                const size_t from = getPortal( idx );
+                const size_t to = getPortal( exitIdx );
+                _portals[from].exits.emplace_back( to, Direction::UNKNOWN );
+            }
+        }
+    }
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, "placed " << _portals.size() << " portals for " << _regions.size() << " regions" )
+}
+
+void RegionPathfinder::invalidateTile( const int tileIndex )
+{
+    if ( tileIndex < 0 || static_cast<size_t>( tileIndex ) >= _tileRegionIndex.size() )
+        return;
+
+    const Maps::Tiles & tile = world.GetTiles( tileIndex );
+    const uint32_t regionId = tile.GetRegion();
+    if ( regionId < _regions.size() ) {
+        _regions[regionId].isValid = false;
+    }
+
+    // Teleporters link distant regions so all bounds are recalculated. Otherwise the tile can change only exits of adjacent regions.
+    if ( tile.GetObject( false ) == MP2::OBJ_STONELITHS ) {
+        for ( RegionBounds & bounds : _regionBounds ) {
+            bounds.isValid = false;
+        }
+    }
+    else {
+        if ( regionId < _regionBounds.size() ) {
+            _regionBounds[regionId].isValid = false;
+        }
+
+        const Directions & directions = Direction::All();
+        for ( size_t i = 0; i < directions.size(); ++i ) {
+            if ( !Maps::isValidDirection( tileIndex, directions[i] ) )
+                continue;
+
+            const uint32_t aroundRegionId = world.GetTiles( tileIndex + _mapOffset[i] ).GetRegion();
+            if ( aroundRegionId < _regionBounds.size() ) {
+                _regionBounds[aroundRegionId].isValid = false;
+            }
+        }
+    }
+
+    // The first leg of the route might be affected as well.
+    _pathStart = -1;
+    _boundStart = -1;
+}
+
+uint32_t RegionPathfinder::getDistance( const int start, const int targetIndex, const uint8_t skill )
+{
+    _firstLegTarget = -1;
+    _portalRoute.clear();
+
+    if ( _tileRegionIndex.size() != world.getSize() ) {
+        rebuild();
+    }
+
+    if ( start < 0 || targetIndex < 0 || start == targetIndex || static_cast<size_t>( start ) >= _tileRegionIndex.size()
+         || static_cast<size_t>( targetIndex ) >= _tileRegionIndex.size() || _tileRegionIndex[targetIndex] < 0 ) {
+        return 0;
+    }
+
+    if ( _pathfindingSkill != skill ) {
+        _pathfindingSkill = skill;
+        _pathStart = -1;
+
+        for ( RegionCache & region : _regions ) {
+            region.isValid = false;
+        }
+    }
+
+    // The first leg is explored tile by tile within the start region.
+    if ( _pathStart != start ) {
+        _pathStart = start;
+        _currentColor = Color::NONE;
+        _remainingMovePoints = 0;
+        _maxMovePoints = 0;
+
+        processWorldMap( start );
+    }
+
+    uint32_t bestCost = ( _cache[targetIndex]._from != -1 ) ? _cache[targetIndex]._cost : noRegionPath;
+    size_t bestPortal = noPortal;
+
+    std::vector<uint32_t> portalCost( _portals.size(), noRegionPath );
+    std::vector<size_t> portalFrom( _portals.size(), noPortal );
+
+    using QueueItem = std::pair<uint32_t, size_t>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> portalsToExplore;
+
+    for ( size_t portalId = 0; portalId < _portals.size(); ++portalId ) {
+        const int portalIdx = _portals[portalId].index;
+        if ( portalIdx == start || _cache[portalIdx]._from != -1 ) {
+            portalCost[portalId] = _cache[portalIdx]._cost;
+            portalsToExplore.emplace( portalCost[portalId], portalId );
+        }
+    }
+
+    const uint32_t targetRegion = world.GetTiles( targetIndex ).GetRegion();
+
+    auto updatePortal = [&portalCost, &portalFrom, &portalsToExplore]( const size_t portalId, const size_t fromPortalId, const uint32_t cost ) {
+        if ( cost < portalCost[portalId] ) {
+            portalCost[portalId] = cost;
+            portalFrom[portalId] = fromPortalId;
+            portalsToExplore.emplace( cost, portalId );
+        }
+    };
+
+    while ( !portalsToExplore.empty() ) {
+        const QueueItem current = portalsToExplore.top();
+        portalsToExplore.pop();
+
+        if ( current.first >= bestCost )
+            break;
+
+        const size_t portalId = current.second;
+        if ( current.first != portalCost[portalId] )
+            continue;
+
+        const Portal & portal = _portals[portalId];
+        if ( portal.index != start && isRegionTileBlocked( portal.index ) )
+            continue;
+
+        const RegionCache & region = _getRegionCache( portal.region );
+        const uint32_t * costs = region.costs.data() + portal.regionPortalId * region.tiles.size();
+
+        if ( portal.region == targetRegion ) {
+            const uint32_t cost = costs[_tileRegionIndex[targetIndex]];
+            if ( cost != noRegionPath && current.first + cost < bestCost ) {
+                bestCost = current.first + cost;
+                bestPortal = portalId;
+            }
+        }
+
+        for ( const size_t otherPortalId : region.portals ) {
+            const uint32_t cost = costs[_tileRegionIndex[_portals[otherPortalId].index]];
+            if ( otherPortalId != portalId && cost != noRegionPath ) {
+                updatePortal( otherPortalId, portalId, current.first + cost );
+            }
+        }
+
+        for ( const std::pair<size_t, int> & exit : portal.exits ) {
+            if ( exit.second == Direction::UNKNOWN ) {
+                updatePortal( exit.first, portalId, current.first );
+            }
+            else if ( isValidPath( portal.index, exit.second, Color::NONE ) ) {
+                updatePortal( exit.first, portalId, current.first + getMovementPenalty( portal.index, _portals[exit.first].index, exit.second ) );
+            }
+        }
+    }
+
+    if ( bestCost == noRegionPath )
+        return 0;
+
+    if ( bestPortal == noPortal ) {
+        _firstLegTarget = targetIndex;
+    }
+    else {
+        _portalRoute.push_back( targetIndex );
+
+        size_t portalId = bestPortal;
+        while ( portalFrom[portalId] != noPortal ) {
+            _portalRoute.push_back( _portals[portalId].index );
+            portalId = portalFrom[portalId];
+        }
+
+        _firstLegTarget = _portals[portalId].index;
+        std::reverse( _portalRoute.begin(), _portalRoute.end() );
+    }
+
+    return bestCost;
+}
+
+Route::StepList RegionPathfinder::buildPath() const
+{
+    Route::StepList path;
+
+    // trace the path from end point
+    int currentNode = _firstLegTarget;
+    while ( currentNode != _pathStart && currentNode != -1 ) {
+        const WorldNode & node = _cache[currentNode];
+        const uint32_t cost = ( node._from != -1 ) ? node._cost - _cache[node._from]._cost : node._cost;
+
+        path.emplace_back( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+
+        currentNode = node._from;
+    }
+
+    // the path was traced from the end point
+    std::reverse( path.begin(), path.end() );
+
+    return path;
+}
+
+// Restricts tile by tile search to the start region. Tiles of adjacent regions are reached but not explored further.
+void RegionPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, int pathStart, int currentNodeIdx )
+{
+    if ( currentNodeIdx != pathStart
+         && ( world.GetTiles( currentNodeIdx ).GetRegion() != world.GetTiles( pathStart ).GetRegion() || isRegionTileBlocked( currentNodeIdx ) ) ) {
+        return;
+    }
+
+    checkAdjacentNodes( nodesToExplore, pathStart, currentNodeIdx );
+}
+
+const RegionPathfinder::RegionCache & RegionPathfinder::_getRegionCache( const uint32_t regionId )
+{
+    RegionCache & region = _regions[regionId];
+    if ( region.isValid )
+        return region;
+
+    const size_t tileCount = region.tiles.size();
+    region.costs.assign( region.portals.size() * tileCount, noRegionPath );
+
+    const Directions & directions = Direction::All();
+
+    using QueueItem = std::pair<uint32_t, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> nodesToExplore;
+
+    for ( size_t row = 0; row < region.portals.size(); ++row ) {
+        uint32_t * costs = region.costs.data() + row * tileCount;
+        const int source = _portals[region.portals[row]].index;
+
+        costs[_tileRegionIndex[source]] = 0;
+        nodesToExplore.emplace( 0, source );
+
+        while ( !nodesToExplore.empty() ) {
+            const QueueItem current = nodesToExplore.top();
+            nodesToExplore.pop();
+
+            const int currentIdx = current.second;
+            if ( current.first != costs[_tileRegionIndex[currentIdx]] )
+                continue;
+
+            if ( currentIdx != source && isRegionTileBlocked( currentIdx ) )
+                continue;
+
+            for ( size_t i = 0; i < directions.size(); ++i ) {
+                if ( !Maps::isValidDirection( currentIdx, directions[i] ) )
+                    continue;
+
+                const int newIndex = currentIdx + _mapOffset[i];
+                if ( world.GetTiles( newIndex ).GetRegion() != regionId || !isValidPath( currentIdx, directions[i], Color::NONE ) )
+                    continue;
+
+                const uint32_t cost = current.first + getMovementPenalty( currentIdx, newIndex, directions[i] );
+                uint32_t & newCost = costs[_tileRegionIndex[newIndex]];
+                if ( cost < newCost ) {
+                    newCost = cost;
+                    nodesToExplore.emplace( cost, newIndex );
+                }
+            }
+        }
+    }
+
+    region.isValid = true;
+
+    return region;
+}
+
+const RegionPathfinder::RegionBounds & RegionPathfinder::_getRegionBounds( const uint32_t regionId )
+{
+    RegionBounds & bounds = _regionBounds[regionId];
+    if ( bounds.isValid )
+        return bounds;
+
+    bounds.neighbours.clear();
+    bounds.exits.clear();
+
+    // Tiles of this region entered from every neighbour
+    std::vector<std::vector<int>> entries;
+
+    auto getNeighbourId = [&bounds, &entries]( const uint32_t neighbourId ) {
+        const std::vector<uint32_t>::const_iterator it = std::find( bounds.neighbours.begin(), bounds.neighbours.end(), neighbourId );
+        if ( it != bounds.neighbours.end() )
+            return static_cast<size_t>( it - bounds.neighbours.begin() );
+
+        bounds.neighbours.push_back( neighbourId );
+        bounds.exits.emplace_back();
+        entries.emplace_back();
+
+        return bounds.neighbours.size() - 1;
+    };
+
+    auto addTile = []( std::vector<int> & tiles, const int index ) {
+        if ( tiles.empty() || tiles.back() != index )
+            tiles.push_back( index );
+    };
+
+    const Directions & directions = Direction::All();
+    const std::vector<int> & tiles = _regions[regionId].tiles;
+
+    for ( const int idx : tiles ) {
+        for ( size_t i = 0; i < directions.size(); ++i ) {
+            if ( !Maps::isValidDirection( idx, directions[i] ) )
+                continue;
+
+            const int newIndex = idx + _mapOffset[i];
+            if ( _tileRegionIndex[newIndex] < 0 )
+                continue;
+
+            const uint32_t newRegionId = world.GetTiles( newIndex ).GetRegion();
+            if ( newRegionId == regionId )
+                continue;
+
+            if ( isPassableIgnoringObjects( idx, directions[i] ) )
+                addTile( bounds.exits[getNeighbourId( newRegionId )], idx );
+
+            if ( isPassableIgnoringObjects( newIndex, Direction::Reflect( directions[i] ) ) )
+                addTile( entries[getNeighbourId( newRegionId )], idx );
+        }
+
+        for ( const int exitIdx : world.GetTeleportEndPoints( idx ) ) {
+            if ( _tileRegionIndex[exitIdx] < 0 )
+                continue;
+
+            const uint32_t exitRegionId = world.GetTiles( exitIdx ).GetRegion();
+            if ( exitRegionId != regionId ) {
+                const size_t neighbourId = getNeighbourId( exitRegionId );
+                addTile( bounds.exits[neighbourId], idx );
+                addTile( entries[neighbourId], idx );
+            }
+        }
+    }
+
+    const size_t tileCount = tiles.size();
+    const size_t neighbourCount = bounds.neighbours.size();
+
+    bounds.costs.assign( neighbourCount * tileCount, noRegionPath );
+    bounds.exitCosts.assign( neighbourCount * neighbourCount, noRegionPath );
+
+    for ( size_t row = 0; row < neighbourCount; ++row ) {
+        if ( entries[row].empty() )
+            continue;
+
+        uint32_t * costs = bounds.costs.data() + row * tileCount;
+        _computeMinimumCosts( regionId, entries[row], costs );
+
+        for ( size_t column = 0; column < neighbourCount; ++column ) {
+            uint32_t & exitCost = bounds.exitCosts[row * neighbourCount + column];
+
+            for ( const int exitIdx : bounds.exits[column] ) {
+                exitCost = std::min( exitCost, costs[_tileRegionIndex[exitIdx]] );
+            }
+        }
+    }
+
+    bounds.isValid = true;
+
+    return bounds;
+}
+
+void RegionPathfinder::_computeMinimumCosts( const uint32_t regionId, const std::vector<int> & sources, uint32_t * costs ) const
+{
+    using QueueItem = std::pair<uint32_t, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> nodesToExplore;
+
+    auto updateNode = [this, costs, &nodesToExplore]( const int index, const uint32_t cost ) {
+        uint32_t & nodeCost = costs[_tileRegionIndex[index]];
+        if ( cost < nodeCost ) {
+            nodeCost = cost;
+            nodesToExplore.emplace( cost, index );
+        }
+    };
+
+    for ( const int source : sources ) {
+        updateNode( source, 0 );
+    }
+
+    const Directions & directions = Direction::All();
+
+    while ( !nodesToExplore.empty() ) {
+        const QueueItem current = nodesToExplore.top();
+        nodesToExplore.pop();
+
+        const int currentIdx = current.second;
+        if ( current.first != costs[_tileRegionIndex[currentIdx]] )
+            continue;
+
+        for ( size_t i = 0; i < directions.size(); ++i ) {
+            if ( !Maps::isValidDirection( currentIdx, directions[i] ) )
+                continue;
+
+            const int newIndex = currentIdx + _mapOffset[i];
+            if ( world.GetTiles( newIndex ).GetRegion() != regionId || !isPassableIgnoringObjects( currentIdx, directions[i] ) )
+                continue;
+
+            // Expert pathfinding gives the lowest penalties
+            updateNode( newIndex, current.first + calculateMovementPenalty( currentIdx, newIndex, directions[i], Skill::Level::EXPERT, false, 0 ) );
+        }
+
+        for ( const int exitIdx : world.GetTeleportEndPoints( currentIdx ) ) {
+            if ( world.GetTiles( exitIdx ).GetRegion() == regionId ) {
+                updateNode( exitIdx, current.first );
+            }
+        }
+    }
+}
+
+void RegionPathfinder::_evaluateMinimumDistances( const int start )
+{
+    _boundStart = start;
+
+    const uint32_t startRegionId = world.GetTiles( start ).GetRegion();
+
+    _boundStartCosts.assign( _regions[startRegionId].tiles.size(), noRegionPath );
+    _computeMinimumCosts( startRegionId, { start }, _boundStartCosts.data() );
+
+    _boundEntryCosts.clear();
+    _boundEntryCosts.resize( _regions.size() );
+
+    // Dijkstra search over region entries: a region entered from one neighbour is a different node than the same region entered from another one.
+    using RegionEntry = std::pair<uint32_t, size_t>;
+    using QueueItem = std::pair<uint32_t, RegionEntry>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> entriesToExplore;
+
+    auto updateEntry = [this, &entriesToExplore]( const uint32_t regionId, const uint32_t fromRegionId, const uint32_t cost ) {
+        const RegionBounds & bounds = _getRegionBounds( regionId );
+
+        const std::vector<uint32_t>::const_iterator it = std::find( bounds.neighbours.begin(), bounds.neighbours.end(), fromRegionId );
+        if ( it == bounds.neighbours.end() )
+            return;
+
+        std::vector<uint32_t> & entryCosts = _boundEntryCosts[regionId];
+        if ( entryCosts.empty() )
+            entryCosts.assign( bounds.neighbours.size(), noRegionPath );
+
+        const size_t entryId = static_cast<size_t>( it - bounds.neighbours.begin() );
+        if ( cost < entryCosts[entryId] ) {
+            entryCosts[entryId] = cost;
+            entriesToExplore.emplace( cost, RegionEntry( regionId, entryId ) );
+        }
+    };
+
+    const RegionBounds & startBounds = _getRegionBounds( startRegionId );
+    for ( size_t neighbourId = 0; neighbourId < startBounds.neighbours.size(); ++neighbourId ) {
+        uint32_t exitCost = noRegionPath;
+        for ( const int exitIdx : startBounds.exits[neighbourId] ) {
+            exitCost = std::min( exitCost, _boundStartCosts[_tileRegionIndex[exitIdx]] );
+        }
+
+        if ( exitCost != noRegionPath ) {
+            updateEntry( startBounds.neighbours[neighbourId], startRegionId, exitCost );
+        }
+    }
+
+    while ( !entriesToExplore.empty() ) {
+        const QueueItem current = entriesToExplore.top();
+        entriesToExplore.pop();
+
+        const uint32_t regionId = current.second.first;
+        const size_t entryId = current.second.second;
+        if ( current.first != _boundEntryCosts[regionId][entryId] )
+            continue;
+
+        const RegionBounds & bounds = _getRegionBounds( regionId );
+        const size_t neighbourCount = bounds.neighbours.size();
+
+        for ( size_t neighbourId = 0; neighbourId < neighbourCount; ++neighbourId ) {
+            const uint32_t exitCost = bounds.exitCosts[entryId * neighbourCount + neighbourId];
+            if ( exitCost != noRegionPath ) {
+                updateEntry( bounds.neighbours[neighbourId], regionId, current.first + exitCost );
+            }
+        }
+    }
+}
+
+uint32_t RegionPathfinder::getMinimumDistance( const int start, const int targetIndex )
+{
+    if ( _tileRegionIndex.size() != world.getSize() ) {
+        rebuild();
+    }
+
+    if ( start < 0 || targetIndex < 0 || static_cast<size_t>( start ) >= _tileRegionIndex.size() || static_cast<size_t>( targetIndex ) >= _tileRegionIndex.size()
+         || _tileRegionIndex[start] < 0 || _tileRegionIndex[targetIndex] < 0 ) {
+        return 0;
+    }
+
+    if ( _boundStart != start ) {
+        _evaluateMinimumDistances( start );
+    }
+
+    const uint32_t targetRegionId = world.GetTiles( targetIndex ).GetRegion();
+    const size_t targetTileId = static_cast<size_t>( _tileRegionIndex[targetIndex] );
+
+    uint32_t distance = ( targetRegionId == world.GetTiles( start ).GetRegion() ) ? _boundStartCosts[targetTileId] : noRegionPath;
+
+    const std::vector<uint32_t> & entryCosts = _boundEntryCosts[targetRegionId];
+    if ( !entryCosts.empty() ) {
+        const RegionBounds & bounds = _getRegionBounds( targetRegionId );
+        const size_t tileCount = _regions[targetRegionId].tiles.size();
+
+        for ( size_t entryId = 0; entryId < entryCosts.size(); ++entryId ) {
+            const uint32_t cost = bounds.costs[entryId * tileCount + targetTileId];
+            if ( entryCosts[entryId] != noRegionPath && cost != noRegionPath ) {
+                distance = std::min( distance, entryCosts[entryId] + cost );
+            }
+        }
+    }
+
+    return distance;
+}
@@ -87,7 +87,12 @@ public:
     void reset() override;
 
     void reEvaluateIfNeeded( const Heroes & hero );
-    std::list<Route::Step> buildPath( int targetIndex ) const;
+    Route::StepList buildPath( int targetIndex ) const;
+
+    // Makes the existing path of the hero continue from the current position of the hero if the hero stands on the path or is one step away
+    // from it. The remaining steps are checked against the passability rules and their penalties are recalculated for the current move points
+    // of the hero without a search over the whole map. Returns false if the path has to be built from scratch.
+    static bool reconnectPath( const Heroes & hero, Route::Path & path );
 
 private:
     void processCurrentNode( std::vector<int> & nodesToExplore, int pathStart, int currentNodeIdx ) override;
@@ -117,7 +122,7 @@ public:
     uint32_t getDistance( int start, int targetIndex, int color, double armyStrength, uint8_t skill = Skill::Level::EXPERT );
 
     // Override builds path to the nearest valid object
-    std::list<Route::Step> buildPath( int targetIndex, bool isPlanningMode = false ) const;
+    Route::StepList buildPath( int targetIndex, bool isPlanningMode = false ) const;
 
     // Faster, but does not re-evaluate the map (expose base class method)
     using Pathfinder::getDistance;
@@ -129,9 +134,27 @@ public:
 
     void setArmyStrengthMultplier( const double multiplier );
 
+    // Limits the search for heroes by the movement points of the given number of days. Tiles beyond the limit are reached but not explored
+    // further, so their distances might be longer than the real ones and farther tiles are not reached at all. 0 means no limit.
+    void setSearchDayLimit( const uint32_t days );
+
+    uint32_t getSearchCostLimit() const
+    {
+        return _searchCostLimit;
+    }
+
+    // Returns true if the last search skipped some tiles because of the limit.
+    bool isSearchLimitReached() const
+    {
+        return _isSearchLimitReached;
+    }
+
 private:
     void processCurrentNode( std::vector<int> & nodesToExplore, int pathStart, int currentNodeIdx ) override;
 
+    void _reEvaluateHero( const Heroes & hero, const uint32_t searchCostLimit );
+    int _findFogDiscoveryTile( const Heroes & hero ) const;
+
     // Adds special logic for AI-controlled heroes to encourage them to overcome water obstacles using boats.
     // If this logic should be taken into account (when performing pathfinding for a real hero on the map),
     // then the src tile should be already accessible for this hero and it should also have a valid information
@@ -140,5 +163,110 @@ private:
 
     double _armyStrength = -1;
     double _advantage = 1.0;
+    uint32_t _searchDayLimit = 0;
+    uint32_t _searchCostLimit = 0;
+    bool _isSearchLimitReached = false;
     Army _temporaryArmy; // for internal calculations
 };
+
+// Hierarchical pathfinder working on top of World regions (see World::ComputeStaticAnalysis). Regions are connected through portal
+// tiles placed on their borders. Movement costs between portals of the same region are calculated tile by tile on demand and cached
+// until an object within the region changes. Only the part of the route inside the start region is refined to tiles.
+// Generic passability rules are used (no army strength, monster protection or boats) so results are estimations for long-range planning.
+class RegionPathfinder : public WorldPathfinder
+{
+public:
+    RegionPathfinder() = default;
+
+    void reset() override;
+
+    // Places portals for the current World regions. Must be called every time regions are recalculated.
+    void rebuild();
+
+    // Marks cached portal costs of the region containing the tile as outdated.
+    void invalidateTile( const int tileIndex );
+
+    // Returns estimated movement cost from start to target or 0 if target cannot be reached.
+    uint32_t getDistance( const int start, const int targetIndex, const uint8_t skill );
+
+    // Returns the first leg of the route found by the last getDistance() call: steps to the first portal or to the target within the start region.
+    Route::StepList buildPath() const;
+
+    // Returns portal tiles of the route found by the last getDistance() call following the first leg. The last entry is the target.
+    const std::vector<int> & getPortalRoute() const
+    {
+        return _portalRoute;
+    }
+
+    // Returns the last tile of the first leg of the route found by the last getDistance() call or -1 if there is no route.
+    int getFirstLegTarget() const
+    {
+        return _firstLegTarget;
+    }
+
+    // Returns a lower bound of the movement cost from start to target for any army which does not have movement points of a hero (see
+    // AIWorldPathfinder::getDistance()). Objects, fog, boats and coasts do not block the way and region borders are crossed at no cost.
+    // Returns 0 if start or target are outside of regions and std::numeric_limits<uint32_t>::max() if target cannot be reached at all.
+    uint32_t getMinimumDistance( const int start, const int targetIndex );
+
+    // Faster, but does not re-evaluate the map (expose base class method)
+    using Pathfinder::getDistance;
+
+private:
+    struct Portal
+    {
+        int index = -1;
+        uint32_t region = 0;
+        // Position of the portal in the portal list of its region.
+        size_t regionPortalId = 0;
+        // Transitions to portals of other regions: portal ID and direction. Direction::UNKNOWN is used for teleporters.
+        std::vector<std::pair<size_t, int>> exits;
+    };
+
+    struct RegionCache
+    {
+        std::vector<int> tiles;
+        std::vector<size_t> portals;
+        // Movement costs from every region portal (rows) to every region tile (columns).
+        std::vector<uint32_t> costs;
+        bool isValid = false;
+    };
+
+    struct RegionBounds
+    {
+        // Regions which can be entered from this region or from which this region can be entered, directly or through a teleporter.
+        std::vector<uint32_t> neighbours;
+        // Tiles of this region leading to every neighbour.
+        std::vector<std::vector<int>> exits;
+        // Lower bounds of movement costs from the tiles entered from every neighbour (rows) to every region tile (columns).
+        std::vector<uint32_t> costs;
+        // Lower bounds of movement costs from the tiles entered from every neighbour (rows) to the exits to every neighbour (columns).
+        std::vector<uint32_t> exitCosts;
+        bool isValid = false;
+    };
+
+    void processCurrentNode( std::vector<int> & nodesToExplore, int pathStart, int currentNodeIdx ) override;
+
+    const RegionCache & _getRegionCache( const uint32_t regionId );
+    const RegionBounds & _getRegionBounds( const uint32_t regionId );
+
+    // Calculates lower bounds of movement costs from the source tiles to every tile of the region.
+    void _computeMinimumCosts( const uint32_t regionId, const std::vector<int> & sources, uint32_t * costs ) const;
+    void _evaluateMinimumDistances( const int start );
+
+    std::vector<Portal> _portals;
+    std::vector<RegionCache> _regions;
+    std::vector<RegionBounds> _regionBounds;
+    // Position of every map tile in the tile list of its region.
+    std::vector<int> _tileRegionIndex;
+    std::vector<int> _tilePortal;
+
+    int _firstLegTarget = -1;
+    std::vector<int> _portalRoute;
+
+    // Start of the last getMinimumDistance() call, lower bounds of costs to the tiles of the start region
+    // and to the tiles entered from every neighbour of every region (in the order of RegionBounds::neighbours).
+    int _boundStart = -1;
+    std::vector<uint32_t> _boundStartCosts;
+    std::vector<std::vector<uint32_t>> _boundEntryCosts;
+};
@@ -347,4 +347,7 @@ void World::ComputeStaticAnalysis()
             }
         }
     }
+
+    // Step 10. Place portals between regions for region-level pathfinding
+    _regionPathfinder.rebuild();
 }